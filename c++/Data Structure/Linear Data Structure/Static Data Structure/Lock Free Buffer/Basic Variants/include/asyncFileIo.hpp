@@ -0,0 +1,418 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define ASYNC_FILE_IO_URING 1
+#endif
+
+// =============================================
+// Asynchronous File I/O on Fixed Buffers
+// =============================================
+// Keeps several reads and writes in flight against a fixed set of
+// aligned buffers owned by the backend. Callers submit operations
+// tagged with a number and later collect completions.
+//
+// Backends:
+//   IoUringFileIo   io_uring with the buffers registered once
+//                   (READ_FIXED / WRITE_FIXED, no per-call pinning)
+//   ThreadedFileIo  one worker thread doing pread / pwritev, used
+//                   when io_uring is missing or disabled
+//
+// Not thread-safe: one thread submits and collects, like the single
+// issuer of an io_uring. The exception is wake(), which any thread may
+// call to cut a blocking complete() short, e.g. when it has work for
+// the issuer that is not I/O.
+class AsyncFileIo {
+public:
+    struct Completion {
+        uint64_t tag;
+        int64_t result; // bytes transferred, or -errno
+    };
+
+    AsyncFileIo(size_t buffer_count, size_t buffer_size)
+        : count(buffer_count), size(buffer_size) {
+        storage = static_cast<char*>(std::aligned_alloc(4096, (count * size + 4095) / 4096 * 4096));
+        if (!storage) {
+            throw std::runtime_error("Failed to allocate I/O buffers");
+        }
+    }
+
+    virtual ~AsyncFileIo() { std::free(storage); }
+
+    AsyncFileIo(const AsyncFileIo&) = delete;
+    AsyncFileIo& operator=(const AsyncFileIo&) = delete;
+
+    char* buffer(size_t index) { return storage + index * size; }
+    size_t bufferCount() const { return count; }
+    size_t bufferSize() const { return size; }
+
+    // Read/write `length` bytes at `offset`, into/from buffer `index`
+    // starting `buffer_offset` bytes in
+    virtual void submitRead(int fd, size_t index, size_t buffer_offset, size_t length,
+                            uint64_t offset, uint64_t tag) = 0;
+    virtual void submitWrite(int fd, size_t index, size_t buffer_offset, size_t length,
+                             uint64_t offset, uint64_t tag) = 0;
+
+    // Hands submitted operations to the kernel/worker, collects up to
+    // out.size() completions, blocking until at least `min_complete`
+    // are available or wake() is called. Returns how many were stored.
+    virtual size_t complete(std::span<Completion> out, size_t min_complete) = 0;
+
+    // Makes the current or next blocking complete() return. Wake-ups
+    // do not queue up: several before one complete() count as one.
+    virtual void wake() = 0;
+
+    virtual const char* name() const = 0;
+
+protected:
+    size_t count;
+    size_t size;
+    char* storage;
+};
+
+#ifdef ASYNC_FILE_IO_URING
+
+// wake() writes to an eventfd. The ring always has a read of that
+// eventfd in flight, so the write completes it and ends the wait in
+// io_uring_enter; complete() re-arms the read and does not report it.
+class IoUringFileIo : public AsyncFileIo {
+    static constexpr uint64_t wake_tag = UINT64_MAX;
+
+    int ring_fd = -1;
+    int wake_fd = -1;
+    uint64_t wake_count = 0;
+    iovec wake_iov{&wake_count, sizeof(wake_count)};
+
+    void* sq_ring = nullptr;
+    size_t sq_ring_size = 0;
+    void* cq_ring = nullptr;
+    size_t cq_ring_size = 0;
+    io_uring_sqe* sqes = nullptr;
+    size_t sqes_size = 0;
+
+    unsigned* sq_tail;
+    unsigned* sq_mask;
+    unsigned* sq_array;
+    unsigned* cq_head;
+    unsigned* cq_tail;
+    unsigned* cq_mask;
+    io_uring_cqe* cqes;
+
+    unsigned to_submit = 0;
+
+    template<typename P>
+    static P* at(void* base, uint32_t offset) {
+        return reinterpret_cast<P*>(static_cast<char*>(base) + offset);
+    }
+
+    void release() {
+        if (sqes) munmap(sqes, sqes_size);
+        if (cq_ring && cq_ring != sq_ring) munmap(cq_ring, cq_ring_size);
+        if (sq_ring) munmap(sq_ring, sq_ring_size);
+        if (ring_fd >= 0) close(ring_fd);
+        if (wake_fd >= 0) close(wake_fd);
+    }
+
+    // The next free SQ entry, cleared; push() publishes it
+    io_uring_sqe& nextEntry() {
+        // Only this thread writes the SQ tail
+        io_uring_sqe& sqe = sqes[*sq_tail & *sq_mask];
+        std::memset(&sqe, 0, sizeof(sqe));
+        return sqe;
+    }
+
+    void push() {
+        unsigned tail = *sq_tail;
+        unsigned slot = tail & *sq_mask;
+        sq_array[slot] = slot;
+        std::atomic_ref<unsigned>(*sq_tail).store(tail + 1, std::memory_order_release);
+        ++to_submit;
+    }
+
+    void submit(uint8_t opcode, int fd, size_t index, size_t buffer_offset, size_t length,
+                uint64_t offset, uint64_t tag) {
+        io_uring_sqe& sqe = nextEntry();
+        sqe.opcode = opcode;
+        sqe.fd = fd;
+        sqe.addr = reinterpret_cast<uint64_t>(buffer(index) + buffer_offset);
+        sqe.len = static_cast<uint32_t>(length);
+        sqe.off = offset;
+        sqe.buf_index = static_cast<uint16_t>(index);
+        sqe.user_data = tag;
+        push();
+    }
+
+    void armWake() {
+        io_uring_sqe& sqe = nextEntry();
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = wake_fd;
+        sqe.addr = reinterpret_cast<uint64_t>(&wake_iov);
+        sqe.len = 1;
+        sqe.user_data = wake_tag;
+        push();
+    }
+
+public:
+    // Throws if the kernel has no (or a disabled) io_uring
+    IoUringFileIo(size_t buffer_count, size_t buffer_size) : AsyncFileIo(buffer_count, buffer_size) {
+        io_uring_params params {};
+        // Every buffer has at most one operation in flight, plus the
+        // eventfd read
+        ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, static_cast<unsigned>(2 * buffer_count + 1), &params));
+        if (ring_fd < 0) {
+            throw std::runtime_error("io_uring_setup failed");
+        }
+
+        sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) {
+            sq_ring_size = cq_ring_size = std::max(sq_ring_size, cq_ring_size);
+        }
+
+        sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       ring_fd, IORING_OFF_SQ_RING);
+        if (sq_ring == MAP_FAILED) {
+            sq_ring = nullptr;
+            release();
+            throw std::runtime_error("Failed to map io_uring submission ring");
+        }
+        cq_ring = single_mmap ? sq_ring
+                              : mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                     ring_fd, IORING_OFF_CQ_RING);
+        if (cq_ring == MAP_FAILED) {
+            cq_ring = nullptr;
+            release();
+            throw std::runtime_error("Failed to map io_uring completion ring");
+        }
+        sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqe_area = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                              ring_fd, IORING_OFF_SQES);
+        if (sqe_area == MAP_FAILED) {
+            release();
+            throw std::runtime_error("Failed to map io_uring entries");
+        }
+        sqes = static_cast<io_uring_sqe*>(sqe_area);
+
+        sq_tail = at<unsigned>(sq_ring, params.sq_off.tail);
+        sq_mask = at<unsigned>(sq_ring, params.sq_off.ring_mask);
+        sq_array = at<unsigned>(sq_ring, params.sq_off.array);
+        cq_head = at<unsigned>(cq_ring, params.cq_off.head);
+        cq_tail = at<unsigned>(cq_ring, params.cq_off.tail);
+        cq_mask = at<unsigned>(cq_ring, params.cq_off.ring_mask);
+        cqes = at<io_uring_cqe>(cq_ring, params.cq_off.cqes);
+
+        // Pin the buffers once so READ_FIXED/WRITE_FIXED skip per-call mapping
+        std::vector<iovec> iovecs(count);
+        for (size_t i = 0; i < count; ++i) {
+            iovecs[i] = {buffer(i), size};
+        }
+        if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_BUFFERS,
+                    iovecs.data(), static_cast<unsigned>(count)) != 0) {
+            release();
+            throw std::runtime_error("Failed to register io_uring buffers");
+        }
+
+        wake_fd = eventfd(0, EFD_CLOEXEC);
+        if (wake_fd < 0) {
+            release();
+            throw std::runtime_error("Failed to create io_uring wake-up eventfd");
+        }
+        armWake();
+    }
+
+    ~IoUringFileIo() override { release(); }
+
+    void submitRead(int fd, size_t index, size_t buffer_offset, size_t length,
+                    uint64_t offset, uint64_t tag) override {
+        submit(IORING_OP_READ_FIXED, fd, index, buffer_offset, length, offset, tag);
+    }
+
+    void submitWrite(int fd, size_t index, size_t buffer_offset, size_t length,
+                     uint64_t offset, uint64_t tag) override {
+        submit(IORING_OP_WRITE_FIXED, fd, index, buffer_offset, length, offset, tag);
+    }
+
+    size_t complete(std::span<Completion> out, size_t min_complete) override {
+        unsigned head = *cq_head;
+        unsigned ready = std::atomic_ref<unsigned>(*cq_tail).load(std::memory_order_acquire) - head;
+
+        if (to_submit > 0 || ready < min_complete) {
+            unsigned wait_for = ready < min_complete ? static_cast<unsigned>(min_complete) : 0;
+            long rc = syscall(__NR_io_uring_enter, ring_fd, to_submit, wait_for,
+                              wait_for ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (rc < 0 && errno != EINTR) {
+                throw std::runtime_error("io_uring_enter failed");
+            }
+            if (rc > 0) to_submit -= static_cast<unsigned>(rc);
+        }
+
+        unsigned tail = std::atomic_ref<unsigned>(*cq_tail).load(std::memory_order_acquire);
+        size_t n = 0;
+        bool woken = false;
+        while (head != tail && n < out.size()) {
+            const io_uring_cqe& cqe = cqes[head & *cq_mask];
+            if (cqe.user_data == wake_tag) {
+                if (cqe.res < 0 && cqe.res != -EINTR) {
+                    throw std::runtime_error("io_uring wake-up read failed");
+                }
+                woken = true;
+            } else {
+                out[n++] = {cqe.user_data, cqe.res};
+            }
+            ++head;
+        }
+        std::atomic_ref<unsigned>(*cq_head).store(head, std::memory_order_release);
+        if (woken) armWake(); // submitted with the next complete()
+        return n;
+    }
+
+    void wake() override {
+        uint64_t one = 1;
+        // Only fails if the counter is about to overflow, i.e. a wake-up is pending anyway
+        [[maybe_unused]] ssize_t rc = write(wake_fd, &one, sizeof(one));
+    }
+
+    const char* name() const override { return "io_uring"; }
+};
+
+#endif // ASYNC_FILE_IO_URING
+
+class ThreadedFileIo : public AsyncFileIo {
+    struct Request {
+        bool write;
+        int fd;
+        char* data;
+        size_t length;
+        uint64_t offset;
+        uint64_t tag;
+    };
+
+    std::mutex mutex;
+    std::condition_variable work_ready;
+    std::condition_variable done_ready;
+    std::deque<Request> requests;
+    std::deque<Completion> completions;
+    bool stop = false;
+    bool woken = false;
+    std::thread worker;
+
+    void enqueue(Request request) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            requests.push_back(request);
+        }
+        work_ready.notify_one();
+    }
+
+    void run() {
+        while (true) {
+            Request r;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                work_ready.wait(lock, [this] { return stop || !requests.empty(); });
+                if (stop && requests.empty()) return;
+                r = requests.front();
+                requests.pop_front();
+            }
+
+            ssize_t result;
+            if (r.write) {
+                iovec iov{r.data, r.length};
+                result = pwritev(r.fd, &iov, 1, static_cast<off_t>(r.offset));
+            } else {
+                result = pread(r.fd, r.data, r.length, static_cast<off_t>(r.offset));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                completions.push_back({r.tag, result < 0 ? -static_cast<int64_t>(errno) : result});
+            }
+            done_ready.notify_one();
+        }
+    }
+
+public:
+    ThreadedFileIo(size_t buffer_count, size_t buffer_size)
+        : AsyncFileIo(buffer_count, buffer_size), worker([this] { run(); }) {}
+
+    ~ThreadedFileIo() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        work_ready.notify_all();
+        worker.join();
+    }
+
+    void submitRead(int fd, size_t index, size_t buffer_offset, size_t length,
+                    uint64_t offset, uint64_t tag) override {
+        enqueue({false, fd, buffer(index) + buffer_offset, length, offset, tag});
+    }
+
+    void submitWrite(int fd, size_t index, size_t buffer_offset, size_t length,
+                     uint64_t offset, uint64_t tag) override {
+        enqueue({true, fd, buffer(index) + buffer_offset, length, offset, tag});
+    }
+
+    size_t complete(std::span<Completion> out, size_t min_complete) override {
+        std::unique_lock<std::mutex> lock(mutex);
+        done_ready.wait(lock, [&] { return woken || completions.size() >= min_complete; });
+        woken = false;
+        size_t n = 0;
+        while (!completions.empty() && n < out.size()) {
+            out[n++] = completions.front();
+            completions.pop_front();
+        }
+        return n;
+    }
+
+    void wake() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            woken = true;
+        }
+        done_ready.notify_one();
+    }
+
+    const char* name() const override { return "pread/pwritev thread"; }
+};
+
+// io_uring when the kernel allows it, otherwise the worker thread
+inline std::unique_ptr<AsyncFileIo> makeAsyncFileIo(size_t buffer_count, size_t buffer_size,
+                                                    bool allow_io_uring = true) {
+#ifdef ASYNC_FILE_IO_URING
+    if (allow_io_uring) {
+        try {
+            return std::make_unique<IoUringFileIo>(buffer_count, buffer_size);
+        } catch (const std::exception&) {
+            // fall through to the portable backend
+        }
+    }
+#endif
+    (void)allow_io_uring;
+    return std::make_unique<ThreadedFileIo>(buffer_count, buffer_size);
+}
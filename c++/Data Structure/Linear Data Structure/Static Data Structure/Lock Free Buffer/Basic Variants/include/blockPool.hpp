@@ -0,0 +1,103 @@
+#pragma once
+
+#include "mpmcQueue.hpp"
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// =============================================
+// Recycled Fixed-Size Blocks for Hot Objects
+// =============================================
+// Small objects that are made and freed at a high rate (tasks, future
+// states) come from here instead of the heap. Every block size has:
+//  * a per-thread cache: a plain array, no atomics, up to
+//    `cache_limit` blocks;
+//  * a shared overflow list, an MpmcQueue as in ChunkPool.
+// A free goes into the freeing thread's cache, then the shared list,
+// and only then back to the heap. An allocation takes from the cache,
+// then the shared list, and only then from the heap. A producer /
+// consumer pair, where one thread allocates and another frees, thus
+// settles into passing blocks through the shared list. Once warm, no
+// heap calls are made.
+//
+// poolNew<T>(args...) / poolDelete(p) are new / delete over this pool.
+template<size_t Size, size_t Align>
+class BlockPool {
+    static constexpr size_t cache_limit = 64;
+    static constexpr size_t shared_limit = 4096;
+
+    static void* heapAllocate() { return ::operator new(Size, std::align_val_t(Align)); }
+    static void heapFree(void* block) { ::operator delete(block, std::align_val_t(Align)); }
+
+    struct Shared {
+        MpmcQueue<void*> blocks{shared_limit};
+
+        ~Shared() {
+            void* block = nullptr;
+            while (blocks.try_pop(block)) heapFree(block);
+        }
+    };
+
+    static Shared& shared() {
+        static Shared instance;
+        return instance;
+    }
+
+    struct Cache {
+        void* blocks[cache_limit];
+        size_t count = 0;
+        Shared& overflow = shared(); // built first, so destroyed after every cache
+
+        ~Cache() {
+            while (count > 0) {
+                void* block = blocks[--count];
+                if (!overflow.blocks.try_push(block)) heapFree(block);
+            }
+        }
+    };
+
+    static Cache& cache() {
+        thread_local Cache instance;
+        return instance;
+    }
+
+public:
+    static void* allocate() {
+        Cache& local = cache();
+        if (local.count > 0) return local.blocks[--local.count];
+        void* block = nullptr;
+        if (local.overflow.blocks.try_pop(block)) return block;
+        return heapAllocate();
+    }
+
+    static void deallocate(void* block) {
+        Cache& local = cache();
+        if (local.count < cache_limit) {
+            local.blocks[local.count++] = block;
+        } else if (!local.overflow.blocks.try_push(block)) {
+            heapFree(block);
+        }
+    }
+};
+
+// Sizes round up to 16 bytes so similar types share a pool
+template<typename T>
+using BlockPoolFor = BlockPool<(sizeof(T) + 15) / 16 * 16, alignof(T) < 16 ? 16 : alignof(T)>;
+
+template<typename T, typename... Args>
+T* poolNew(Args&&... args) {
+    void* block = BlockPoolFor<T>::allocate();
+    try {
+        return ::new (block) T(std::forward<Args>(args)...);
+    } catch (...) {
+        BlockPoolFor<T>::deallocate(block);
+        throw;
+    }
+}
+
+template<typename T>
+void poolDelete(T* object) {
+    object->~T();
+    BlockPoolFor<T>::deallocate(object);
+}
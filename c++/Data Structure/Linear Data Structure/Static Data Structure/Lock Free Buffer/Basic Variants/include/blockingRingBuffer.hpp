@@ -0,0 +1,71 @@
+#pragma once
+
+#include "cacheLine.hpp"
+#include "spscRingBuffer.hpp"
+#include "waitStrategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// =============================================
+// Blocking SPSC Ring Buffer
+// =============================================
+// Wraps any of the SPSC buffers (LockFreeBuffer, LockFreeRingBuffer,
+// SpscRingBuffer) and adds push_wait/pop_wait, which replace the
+// sleep_for / yield polling loops of waitingBuffer.cpp and main2.cpp.
+//
+// A side that has to wait spins per its WaitStrategy, then parks on a
+// futex. Each side has its own futex word and "waiting" flag, and the
+// other side only issues a wake-up syscall when that flag is set, so a
+// push never wakes a waiting producer and nobody pays for a syscall
+// while the peer is running (see waitUntil/notifyWaiter).
+template<typename T, size_t Size, template<typename, size_t> class Buffer = SpscRingBuffer>
+class BlockingRingBuffer {
+    Buffer<T, Size> buffer;
+    WaitStrategy strategy;
+
+    // Written by the producer
+    alignas(cacheLineSize) std::atomic<uint32_t> pushEpoch{0};       // bumped to wake the consumer
+    std::atomic<uint32_t> producerWaiting{0};
+
+    // Written by the consumer
+    alignas(cacheLineSize) std::atomic<uint32_t> popEpoch{0};        // bumped to wake the producer
+    std::atomic<uint32_t> consumerWaiting{0};
+
+public:
+    explicit BlockingRingBuffer(WaitStrategy strategy = {}) : strategy(strategy) {}
+
+    BlockingRingBuffer(const BlockingRingBuffer&) = delete;
+    BlockingRingBuffer& operator=(const BlockingRingBuffer&) = delete;
+
+    // Non-blocking, but wake a parked peer
+    bool push(const T& item) {
+        if (!buffer.push(item)) return false;
+        notifyWaiter(pushEpoch, consumerWaiting);
+        return true;
+    }
+
+    bool pop(T& item) {
+        if (!buffer.pop(item)) return false;
+        notifyWaiter(popEpoch, producerWaiting);
+        return true;
+    }
+
+    // Block until there is room / an item, or until `timeout` expires.
+    // Return false only on timeout.
+    bool push_wait(const T& item,
+                   std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) {
+        return waitUntil([&]() { return push(item); }, popEpoch, producerWaiting,
+                         deadlineAfter(timeout), strategy);
+    }
+
+    bool pop_wait(T& item,
+                  std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) {
+        return waitUntil([&]() { return pop(item); }, pushEpoch, consumerWaiting,
+                         deadlineAfter(timeout), strategy);
+    }
+
+    bool isEmpty() const { return buffer.isEmpty(); }
+};
@@ -0,0 +1,166 @@
+#pragma once
+
+#include "cacheLine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <vector>
+
+// =============================================
+// Broadcast (Disruptor-Style) Ring Buffer
+// =============================================
+// One producer, many consumers, and every consumer sees every item.
+// Items are not removed by consumers; each one only advances its own
+// sequence cursor. Positions are free-running 64-bit sequence numbers
+// mapped to slots with the power-of-two mask from LockFreeRingBuffer,
+// so all `Size` slots are usable.
+//
+//  * The producer may overwrite slot `s - Size` only after every
+//    consumer has passed it (the gating sequence). Consumers that
+//    others depend on are always ahead of them, so only the end-of-
+//    chain consumers are checked.
+//  * A consumer may read item `s` once the producer has published it
+//    and every consumer it depends on has processed it. That gives
+//    pipelines like "stats after writer" without a second queue.
+//
+// Register all consumers before the producer starts.
+template<typename T, size_t Size>
+class BroadcastRingBuffer {
+    static_assert((Size & (Size - 1)) == 0, "Size must be a power of 2");
+
+    struct alignas(cacheLineSize) Sequence {
+        std::atomic<int64_t> value{-1};
+    };
+
+    struct ConsumerState {
+        Sequence sequence;
+        std::vector<const Sequence*> dependencies;
+        bool is_leaf = true;
+    };
+
+    // Producer-owned line
+    Sequence cursor;                      // last published sequence
+    alignas(cacheLineSize) int64_t next_sequence = 0;
+    int64_t cached_gating = -1;
+
+    alignas(cacheLineSize) std::vector<T> buffer;
+    std::vector<std::unique_ptr<ConsumerState>> consumers;
+
+    int64_t minimumGatingSequence() const {
+        int64_t minimum = std::numeric_limits<int64_t>::max();
+        for (const auto& c : consumers) {
+            if (c->is_leaf) {
+                minimum = std::min(minimum, c->sequence.value.load(std::memory_order_acquire));
+            }
+        }
+        // No consumers: nothing to protect
+        return minimum == std::numeric_limits<int64_t>::max() ? next_sequence - 1 : minimum;
+    }
+
+public:
+    class Consumer {
+        friend class BroadcastRingBuffer;
+
+        BroadcastRingBuffer* ring = nullptr;
+        ConsumerState* state = nullptr;
+        int64_t cached_available = -1;
+
+        Consumer(BroadcastRingBuffer* ring, ConsumerState* state) : ring(ring), state(state) {}
+
+        // Highest sequence this consumer may read
+        int64_t barrier() const {
+            int64_t available = ring->cursor.value.load(std::memory_order_acquire);
+            for (const Sequence* dependency : state->dependencies) {
+                available = std::min(available, dependency->value.load(std::memory_order_acquire));
+            }
+            return available;
+        }
+
+    public:
+        Consumer() = default;
+
+        // Calls handler(item, sequence) for up to `max_items` ready items
+        // in order, then publishes progress once. Returns the count.
+        template<typename Handler>
+        size_t poll(Handler&& handler, size_t max_items = Size) {
+            int64_t next = state->sequence.value.load(std::memory_order_relaxed) + 1;
+            if (cached_available < next) {
+                cached_available = barrier();
+                if (cached_available < next) return 0;
+            }
+
+            int64_t last = std::min(cached_available, next + static_cast<int64_t>(max_items) - 1);
+            for (int64_t s = next; s <= last; ++s) {
+                handler(static_cast<const T&>(ring->buffer[s & (Size - 1)]), s);
+            }
+            state->sequence.value.store(last, std::memory_order_release);
+            return static_cast<size_t>(last - next + 1);
+        }
+
+        // Single-item convenience: copies the next item out
+        bool pop(T& item) {
+            return poll([&](const T& value, int64_t) { item = value; }, 1) == 1;
+        }
+
+        // Last sequence this consumer has finished with
+        int64_t sequence() const {
+            return state->sequence.value.load(std::memory_order_acquire);
+        }
+    };
+
+    BroadcastRingBuffer() : buffer(Size) {}
+
+    BroadcastRingBuffer(const BroadcastRingBuffer&) = delete;
+    BroadcastRingBuffer& operator=(const BroadcastRingBuffer&) = delete;
+
+    // Registers a consumer that only sees items after every consumer in
+    // `after` has processed them. Not thread-safe: call before producing.
+    Consumer addConsumer(std::initializer_list<Consumer> after = {}) {
+        auto state = std::make_unique<ConsumerState>();
+        state->sequence.value.store(cursor.value.load(std::memory_order_relaxed),
+                                    std::memory_order_relaxed);
+        for (const Consumer& dependency : after) {
+            dependency.state->is_leaf = false;
+            state->dependencies.push_back(&dependency.state->sequence);
+        }
+        consumers.push_back(std::move(state));
+        return Consumer(this, consumers.back().get());
+    }
+
+    // Producer only: slot for the next sequence, or nullptr when the
+    // slowest consumer is a whole lap behind.
+    T* claim() {
+        int64_t wrap_point = next_sequence - static_cast<int64_t>(Size);
+        if (wrap_point > cached_gating) {
+            cached_gating = minimumGatingSequence();
+            if (wrap_point > cached_gating) {
+                return nullptr; // buffer full for the slowest consumer
+            }
+        }
+        return &buffer[next_sequence & (Size - 1)];
+    }
+
+    // Producer only, after a successful claim()
+    void publish() {
+        cursor.value.store(next_sequence, std::memory_order_release);
+        ++next_sequence;
+    }
+
+    bool push(const T& item) {
+        T* slot = claim();
+        if (!slot) return false;
+        *slot = item;
+        publish();
+        return true;
+    }
+
+    // Last published sequence
+    int64_t published() const {
+        return cursor.value.load(std::memory_order_acquire);
+    }
+};
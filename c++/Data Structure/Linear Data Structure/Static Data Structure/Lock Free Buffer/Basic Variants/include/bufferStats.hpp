@@ -0,0 +1,175 @@
+#pragma once
+
+#include "cacheLine.hpp"
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// =============================================
+// Optional Ring Buffer Instrumentation
+// =============================================
+// The SPSC buffers take a Stats policy as their last template argument:
+//     LockFreeRingBuffer<T, 1024>                  no instrumentation
+//     LockFreeRingBuffer<T, 1024, BufferStats>     counters + histogram
+// The default, NoBufferStats, is an empty type of no-op inline hooks
+// stored with [[no_unique_address]], so an uninstrumented buffer has
+// the same layout and code as before.
+//
+// BufferStats keeps what each side sees on its own cache line, written
+// only by that thread (plain load + store, no RMW):
+//   producer: pushes, pushes refused because full, high-water mark
+//   consumer: pops, pops refused because empty, residency histogram
+// Residency is the time an item spent in the ring, from push to pop.
+// Reading the clock costs several times a push, so only every
+// `sample_every`-th slot is timed: the producer stamps it (published
+// with the item by the buffer's own release/acquire on head) and the
+// consumer reads the clock again when it takes it out.
+//
+// stats() returns a snapshot that another thread may take at any time;
+// fields are read one by one, so they can be a few operations apart.
+
+// Log-linear buckets, HDR-histogram style: 8 per power of two, so any
+// value is known to within 1/8 (12.5%) up to 2^63 ns.
+struct ResidencyBuckets {
+    static constexpr unsigned sub_bits = 3;
+    static constexpr size_t sub_count = size_t{1} << sub_bits;
+    static constexpr size_t count = (64 - sub_bits + 1) * sub_count;
+
+    static size_t of(uint64_t value) {
+        if (value < sub_count) return value;
+        unsigned exponent = std::bit_width(value) - 1;
+        size_t sub = (value >> (exponent - sub_bits)) & (sub_count - 1);
+        return (exponent - sub_bits + 1) * sub_count + sub;
+    }
+
+    static uint64_t lowerBound(size_t bucket) {
+        if (bucket < sub_count) return bucket;
+        unsigned exponent = bucket / sub_count + sub_bits - 1;
+        return (sub_count + bucket % sub_count) << (exponent - sub_bits);
+    }
+};
+
+struct BufferStatsSnapshot {
+    uint64_t pushed = 0;
+    uint64_t push_full = 0;  // push/claim/push_n that found no room
+    uint64_t popped = 0;
+    uint64_t pop_empty = 0;  // pop/peek/pop_n that found nothing
+    size_t high_water = 0;   // most items ever in the ring at once
+    size_t capacity = 0;
+    std::array<uint64_t, ResidencyBuckets::count> residency{};
+
+    // Residency at quantile q (0..1), to within one bucket
+    std::chrono::nanoseconds residencyAt(double q) const {
+        uint64_t total = 0;
+        for (uint64_t n : residency) total += n;
+        if (total == 0) return std::chrono::nanoseconds(0);
+
+        uint64_t rank = static_cast<uint64_t>(q * (total - 1));
+        uint64_t seen = 0;
+        for (size_t b = 0; b < residency.size(); ++b) {
+            seen += residency[b];
+            if (seen > rank) return std::chrono::nanoseconds(ResidencyBuckets::lowerBound(b));
+        }
+        return std::chrono::nanoseconds(ResidencyBuckets::lowerBound(residency.size() - 1));
+    }
+};
+
+struct NoBufferStats {
+    static constexpr bool enabled = false;
+
+    explicit NoBufferStats(size_t) {}
+
+    void onPush(size_t, size_t, size_t) {}
+    void onPushFull() {}
+    void onPop(size_t, size_t) {}
+    void onPopEmpty() {}
+};
+
+class BufferStats {
+    using Counter = std::atomic<uint64_t>;
+
+    // Single writer per counter, so no read-modify-write is needed
+    static void add(Counter& counter, uint64_t n = 1) {
+        counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static int64_t now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    struct alignas(cacheLineSize) ProducerSide {
+        Counter pushed{0};
+        Counter push_full{0};
+        Counter high_water{0};
+    };
+
+    struct alignas(cacheLineSize) ConsumerSide {
+        Counter popped{0};
+        Counter pop_empty{0};
+        std::array<Counter, ResidencyBuckets::count> residency{};
+    };
+
+    ProducerSide producer;
+    ConsumerSide consumer;
+    std::vector<int64_t> stamps; // push time per sampled slot
+    size_t slots;
+
+    static bool sampled(size_t slot) { return (slot & (sample_every - 1)) == 0; }
+
+public:
+    static constexpr bool enabled = true;
+    static constexpr size_t sample_every = 16;
+
+    explicit BufferStats(size_t slots) : stamps(slots), slots(slots) {}
+
+    // Producer: `n` items went into slots first.., leaving `occupancy` in the ring
+    void onPush(size_t first, size_t n, size_t occupancy) {
+        int64_t stamp = -1;
+        for (size_t k = 0, slot = first; k < n; ++k, slot = slot + 1 == slots ? 0 : slot + 1) {
+            if (!sampled(slot)) continue;
+            if (stamp < 0) stamp = now();
+            stamps[slot] = stamp;
+        }
+
+        add(producer.pushed, n);
+        if (occupancy > producer.high_water.load(std::memory_order_relaxed)) {
+            producer.high_water.store(occupancy, std::memory_order_relaxed);
+        }
+    }
+
+    void onPushFull() { add(producer.push_full); }
+
+    // Consumer: `n` items left slots first..
+    void onPop(size_t first, size_t n) {
+        int64_t stamp = -1;
+        for (size_t k = 0, slot = first; k < n; ++k, slot = slot + 1 == slots ? 0 : slot + 1) {
+            if (!sampled(slot)) continue;
+            if (stamp < 0) stamp = now();
+            int64_t waited = stamp - stamps[slot];
+            add(consumer.residency[ResidencyBuckets::of(waited > 0 ? waited : 0)]);
+        }
+        add(consumer.popped, n);
+    }
+
+    void onPopEmpty() { add(consumer.pop_empty); }
+
+    BufferStatsSnapshot snapshot() const {
+        BufferStatsSnapshot s;
+        s.pushed = producer.pushed.load(std::memory_order_relaxed);
+        s.push_full = producer.push_full.load(std::memory_order_relaxed);
+        s.high_water = producer.high_water.load(std::memory_order_relaxed);
+        s.popped = consumer.popped.load(std::memory_order_relaxed);
+        s.pop_empty = consumer.pop_empty.load(std::memory_order_relaxed);
+        s.capacity = slots - 1;
+        for (size_t b = 0; b < s.residency.size(); ++b) {
+            s.residency[b] = consumer.residency[b].load(std::memory_order_relaxed);
+        }
+        return s;
+    }
+};
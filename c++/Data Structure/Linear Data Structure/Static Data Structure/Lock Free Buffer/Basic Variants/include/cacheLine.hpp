@@ -0,0 +1,8 @@
+#pragma once
+
+#include <cstddef>
+
+// Size used to pad data that different threads write, so two hot
+// variables never end up on the same cache line (false sharing).
+// 64 bytes matches x86-64 and most ARM cores.
+inline constexpr std::size_t cacheLineSize = 64;
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CASE_CONVERSION_X86 1
+#endif
+
+// =============================================
+// SIMD ASCII Upper-Casing with Runtime Dispatch
+// =============================================
+// Upper-cases 'a'..'z' in place and leaves every other byte alone,
+// the same result as std::toupper in the "C" locale. Kernels:
+//   scalar   1 byte per step, branch-free
+//   SSE2     16 bytes   (every x86-64 CPU)
+//   AVX2     32 bytes
+//   AVX-512  64 bytes, masked tail (needs AVX-512BW)
+// toUpperInPlace() picks the widest kernel the CPU supports on first
+// use (cpuid via __builtin_cpu_supports); every kernel is compiled
+// with a target attribute, so no global -mavx flags are needed.
+
+inline void toUpperScalar(char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        data[i] = static_cast<char>(c - ((static_cast<unsigned>(c - 'a') < 26u) << 5));
+    }
+}
+
+#ifdef CASE_CONVERSION_X86
+
+// Lower-case letters are the bytes with (c - 'a') < 26 unsigned. SSE2
+// and AVX2 only compare signed, so bias by 128 first: 'a'..'z' then
+// map to -128..-103, and "lower" becomes a signed less-than.
+
+__attribute__((target("sse2")))
+inline void toUpperSse2(char* data, size_t size) {
+    const __m128i bias = _mm_set1_epi8(static_cast<char>(128 - 'a'));
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + 26));
+    const __m128i flip = _mm_set1_epi8(0x20);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i lower = _mm_cmplt_epi8(_mm_add_epi8(x, bias), limit);
+        x = _mm_xor_si128(x, _mm_and_si128(lower, flip));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i), x);
+    }
+    toUpperScalar(data + i, size - i);
+}
+
+__attribute__((target("avx2")))
+inline void toUpperAvx2(char* data, size_t size) {
+    const __m256i bias = _mm256_set1_epi8(static_cast<char>(128 - 'a'));
+    const __m256i limit = _mm256_set1_epi8(static_cast<char>(-128 + 26));
+    const __m256i flip = _mm256_set1_epi8(0x20);
+
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i lower = _mm256_cmpgt_epi8(limit, _mm256_add_epi8(x, bias));
+        x = _mm256_xor_si256(x, _mm256_and_si256(lower, flip));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(data + i), x);
+    }
+    toUpperSse2(data + i, size - i);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+inline void toUpperAvx512(char* data, size_t size) {
+    const __m512i a = _mm512_set1_epi8('a');
+    const __m512i letters = _mm512_set1_epi8(26);
+    const __m512i flip = _mm512_set1_epi8(0x20);
+
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m512i x = _mm512_loadu_si512(data + i);
+        __mmask64 lower = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(x, a), letters);
+        _mm512_storeu_si512(data + i, _mm512_mask_sub_epi8(x, lower, x, flip));
+    }
+    if (i < size) {
+        __mmask64 tail = (1ULL << (size - i)) - 1; // size - i < 64
+        __m512i x = _mm512_maskz_loadu_epi8(tail, data + i);
+        __mmask64 lower = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(x, a), letters) & tail;
+        _mm512_mask_storeu_epi8(data + i, tail, _mm512_mask_sub_epi8(x, lower, x, flip));
+    }
+}
+
+#endif // CASE_CONVERSION_X86
+
+using ToUpperKernel = void (*)(char*, size_t);
+
+struct ToUpperDispatch {
+    ToUpperKernel kernel;
+    const char* name;
+};
+
+inline ToUpperDispatch selectToUpperKernel() {
+#ifdef CASE_CONVERSION_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) return {toUpperAvx512, "AVX-512"};
+    if (__builtin_cpu_supports("avx2")) return {toUpperAvx2, "AVX2"};
+    if (__builtin_cpu_supports("sse2")) return {toUpperSse2, "SSE2"};
+#endif
+    return {toUpperScalar, "scalar"};
+}
+
+// Chosen once, on first use
+inline const ToUpperDispatch& toUpperDispatch() {
+    static const ToUpperDispatch dispatch = selectToUpperKernel();
+    return dispatch;
+}
+
+inline void toUpperInPlace(char* data, size_t size) {
+    toUpperDispatch().kernel(data, size);
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "cacheLine.hpp"
+#include "mpmcQueue.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+// =============================================
+// Chunk Pool: Recycled Buffers for a Pipeline
+// =============================================
+// A fixed set of cache-line aligned buffers that circulate instead of
+// being allocated per chunk:
+//
+//   free list --acquire--> producer --queue--> consumer --release--+
+//       ^                                                          |
+//       +----------------------------------------------------------+
+//
+// Chunks travel as plain pointers, so moving one through a queue is a
+// pointer copy. Once every buffer has been through the loop the
+// pipeline makes no heap allocations; the only exception is a chunk
+// asked to hold more than its capacity, which grows once and keeps
+// the larger buffer for its next trip (see grows()).
+//
+// The free list is an MpmcQueue, so any thread may acquire or release.
+// Size the pool for everything that can hold a chunk at once (queue
+// slots + producers + consumer backlog), or producers will wait in
+// acquire() until the consumer gives buffers back.
+struct PooledChunk {
+    char* data = nullptr;
+    size_t size = 0;
+    size_t capacity = 0;
+};
+
+inline std::string_view chunkBytes(const PooledChunk* chunk) {
+    return {chunk->data, chunk->size};
+}
+
+class ChunkPool {
+    std::vector<PooledChunk> chunks;
+    MpmcQueue<PooledChunk*> free_list;
+    std::atomic<uint64_t> grow_count{0};
+
+    static char* allocate(size_t capacity) {
+        size_t rounded = (capacity + cacheLineSize - 1) / cacheLineSize * cacheLineSize;
+        void* memory = std::aligned_alloc(cacheLineSize, rounded);
+        if (!memory) throw std::bad_alloc();
+        return static_cast<char*>(memory);
+    }
+
+public:
+    ChunkPool(size_t count, size_t chunk_capacity) : chunks(count), free_list(count) {
+        if (count == 0 || chunk_capacity == 0) {
+            throw std::runtime_error("ChunkPool needs at least one non-empty chunk");
+        }
+        for (auto& chunk : chunks) {
+            chunk.data = allocate(chunk_capacity);
+            chunk.capacity = chunk_capacity;
+            free_list.try_push(&chunk);
+        }
+    }
+
+    ~ChunkPool() {
+        for (auto& chunk : chunks) std::free(chunk.data);
+    }
+
+    ChunkPool(const ChunkPool&) = delete;
+    ChunkPool& operator=(const ChunkPool&) = delete;
+
+    // Blocks until a buffer is free; nullptr once shut down
+    PooledChunk* acquire() {
+        PooledChunk* chunk = nullptr;
+        return free_list.pop(chunk) ? chunk : nullptr;
+    }
+
+    PooledChunk* try_acquire() {
+        PooledChunk* chunk = nullptr;
+        return free_list.try_pop(chunk) ? chunk : nullptr;
+    }
+
+    void release(PooledChunk* chunk) {
+        chunk->size = 0;
+        free_list.try_push(chunk); // never full: it holds at most every chunk
+    }
+
+    // Makes room for `size` bytes; old contents are not kept
+    void reserve(PooledChunk& chunk, size_t size) {
+        if (size <= chunk.capacity) return;
+        char* larger = allocate(size);
+        std::free(chunk.data);
+        chunk.data = larger;
+        chunk.capacity = size;
+        grow_count.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void assign(PooledChunk& chunk, std::string_view bytes) {
+        reserve(chunk, bytes.size());
+        if (!bytes.empty()) std::memcpy(chunk.data, bytes.data(), bytes.size());
+        chunk.size = bytes.size();
+    }
+
+    // Wakes threads blocked in acquire()
+    void shutdown() { free_list.shutdown(); }
+
+    size_t count() const { return chunks.size(); }
+    uint64_t grows() const { return grow_count.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+// =============================================
+// Coalescing Writer: Many Chunks per writev
+// =============================================
+// Instead of one write + flush per chunk, chunks are collected and
+// written with a single writev once the batch reaches
+// `max_batch_bytes` / `max_batch_chunks`, or once the oldest pending
+// chunk has waited `max_delay`. Durability is a separate, explicit
+// choice:
+//   None        leave it to the page cache
+//   OnClose     fdatasync once at close()
+//   EveryBatch  fdatasync after every writev (and at close())
+enum class Durability { None, OnClose, EveryBatch };
+
+struct WritePolicy {
+    size_t max_batch_bytes = 1 << 20;   // 1 MiB
+    size_t max_batch_chunks = 256;      // also bounded by IOV_MAX
+    std::chrono::microseconds max_delay{2000};
+    Durability durability = Durability::OnClose;
+};
+
+inline std::string_view chunkBytes(const std::string& chunk) {
+    return chunk;
+}
+
+// Chunk is anything chunkBytes() can view: a std::string by default, or
+// a pooled buffer (see chunkPool.hpp). `recycle` is handed every chunk
+// once its bytes are written (or right away if it is empty), so pooled
+// buffers can go back to their free list.
+template<typename Chunk = std::string>
+class CoalescingWriter {
+    using Clock = std::chrono::steady_clock;
+    using Recycle = std::function<void(Chunk&)>;
+
+    int fd;
+    WritePolicy policy;
+    Recycle recycle;
+    std::vector<Chunk> pending;
+    std::vector<iovec> iov;
+    size_t pending_bytes = 0;
+    Clock::time_point oldest;
+
+    uint64_t writev_calls = 0;
+    uint64_t bytes_written = 0;
+
+    void sync() {
+        if (fdatasync(fd) != 0) {
+            throw std::runtime_error("fdatasync failed");
+        }
+    }
+
+public:
+    CoalescingWriter(int fd, WritePolicy policy = {}, Recycle recycle = {})
+        : fd(fd), policy(policy), recycle(std::move(recycle)) {
+        this->policy.max_batch_chunks = std::clamp<size_t>(policy.max_batch_chunks, 1, IOV_MAX);
+        pending.reserve(this->policy.max_batch_chunks);
+        iov.reserve(this->policy.max_batch_chunks);
+    }
+
+    ~CoalescingWriter() {
+        try {
+            flush();
+        } catch (...) {
+            // destructor must not throw; call close() to see errors
+        }
+    }
+
+    CoalescingWriter(const CoalescingWriter&) = delete;
+    CoalescingWriter& operator=(const CoalescingWriter&) = delete;
+
+    void append(Chunk chunk) {
+        size_t size = chunkBytes(chunk).size();
+        if (size == 0) {
+            if (recycle) recycle(chunk);
+            return;
+        }
+        if (pending.empty()) oldest = Clock::now();
+
+        pending_bytes += size;
+        pending.push_back(std::move(chunk));
+
+        if (pending_bytes >= policy.max_batch_bytes || pending.size() >= policy.max_batch_chunks) {
+            flush();
+        }
+    }
+
+    // Time left before the oldest pending chunk must go out
+    std::chrono::nanoseconds timeUntilDue() const {
+        if (pending.empty()) return std::chrono::nanoseconds::max();
+        return std::max<std::chrono::nanoseconds>(std::chrono::nanoseconds(0),
+                                                  oldest + policy.max_delay - Clock::now());
+    }
+
+    void flushIfDue() {
+        if (!pending.empty() && Clock::now() - oldest >= policy.max_delay) {
+            flush();
+        }
+    }
+
+    // Writes everything pending with as few writev calls as possible
+    void flush() {
+        if (pending.empty()) return;
+
+        iov.clear();
+        for (auto& chunk : pending) {
+            std::string_view bytes = chunkBytes(chunk);
+            iov.push_back({const_cast<char*>(bytes.data()), bytes.size()});
+        }
+
+        size_t first = 0;
+        while (first < iov.size()) {
+            ssize_t n = ::writev(fd, iov.data() + first, static_cast<int>(iov.size() - first));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("writev failed");
+            }
+            ++writev_calls;
+            bytes_written += static_cast<uint64_t>(n);
+
+            // Skip what was fully written, trim a partially written entry
+            size_t left = static_cast<size_t>(n);
+            while (first < iov.size() && left >= iov[first].iov_len) {
+                left -= iov[first].iov_len;
+                ++first;
+            }
+            if (first < iov.size()) {
+                iov[first].iov_base = static_cast<char*>(iov[first].iov_base) + left;
+                iov[first].iov_len -= left;
+            }
+        }
+
+        if (recycle) {
+            for (auto& chunk : pending) recycle(chunk);
+        }
+        pending.clear();
+        pending_bytes = 0;
+        if (policy.durability == Durability::EveryBatch) sync();
+    }
+
+    void close() {
+        flush();
+        if (policy.durability != Durability::None) sync();
+    }
+
+    uint64_t writevCalls() const { return writev_calls; }
+    uint64_t bytesWritten() const { return bytes_written; }
+};
@@ -0,0 +1,277 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CSV_PARSER_X86 1
+#endif
+
+// =============================================
+// Zero-Copy SIMD CSV Parsing into Columns
+// =============================================
+// Parsing happens in two passes over the text, as in simdjson:
+//  1. A structural kernel compares 16/32/64 bytes at a time against
+//     the delimiter and '\n', turns the matches into a bitmask and
+//     writes the position of every set bit to an index.
+//  2. The row walker reads only that index. Fields are string_views
+//     into the caller's text and nothing is copied.
+// Kernels are dispatched at runtime the same way as caseConversion.hpp:
+//   scalar   1 byte per step, branch-free
+//   SSE2     16 bytes
+//   AVX2     32 bytes, 64 per mask
+//   AVX-512  64 bytes, masked tail (needs AVX-512BW)
+// Text is scanned one window (64 KiB) at a time, so the index stays
+// in cache. A window only ever ends on a line end.
+//
+// The format is people.txt's: one record per line, with no quoting.
+// Fields cannot contain the delimiter or a newline. A '\r' before the
+// '\n' is dropped and blank lines are skipped.
+//
+// PersonBatch holds `name,age,phone` rows as a structure of arrays:
+// name and phone offsets/lengths into the source text, and age parsed
+// to an integer. Downstream stages can filter and aggregate a column
+// without touching the rest of the record.
+
+// Appends the position of every set bit of `mask`, plus `base`
+inline size_t appendPositions(uint64_t mask, uint32_t base, uint32_t* out, size_t n) {
+    while (mask != 0) {
+        out[n++] = base + static_cast<uint32_t>(std::countr_zero(mask));
+        mask &= mask - 1;
+    }
+    return n;
+}
+
+// Bytes [from, size) of `data`; kernels hand their tail to this
+inline size_t findStructuralsFrom(const char* data, size_t from, size_t size, char delimiter, uint32_t* out,
+                                  size_t n) {
+    for (size_t i = from; i < size; ++i) {
+        out[n] = static_cast<uint32_t>(i);
+        n += (data[i] == delimiter) | (data[i] == '\n');
+    }
+    return n;
+}
+
+// Writes the offset of every delimiter and '\n' in data[0, size) to
+// `out`, which must have room for `size` entries; returns how many
+inline size_t findStructuralsScalar(const char* data, size_t size, char delimiter, uint32_t* out) {
+    return findStructuralsFrom(data, 0, size, delimiter, out, 0);
+}
+
+#ifdef CSV_PARSER_X86
+
+__attribute__((target("sse2")))
+inline size_t findStructuralsSse2(const char* data, size_t size, char delimiter, uint32_t* out) {
+    const __m128i delim = _mm_set1_epi8(delimiter);
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i hit = _mm_or_si128(_mm_cmpeq_epi8(x, delim), _mm_cmpeq_epi8(x, newline));
+        n = appendPositions(static_cast<uint32_t>(_mm_movemask_epi8(hit)), static_cast<uint32_t>(i), out, n);
+    }
+    return findStructuralsFrom(data, i, size, delimiter, out, n);
+}
+
+__attribute__((target("avx2")))
+inline size_t findStructuralsAvx2(const char* data, size_t size, char delimiter, uint32_t* out) {
+    const __m256i delim = _mm256_set1_epi8(delimiter);
+    const __m256i newline = _mm256_set1_epi8('\n');
+
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+        uint32_t lo_hit = _mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(lo, delim), _mm256_cmpeq_epi8(lo, newline)));
+        uint32_t hi_hit = _mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(hi, delim), _mm256_cmpeq_epi8(hi, newline)));
+        n = appendPositions(lo_hit | static_cast<uint64_t>(hi_hit) << 32, static_cast<uint32_t>(i), out, n);
+    }
+    return findStructuralsFrom(data, i, size, delimiter, out, n);
+}
+
+__attribute__((target("avx512f,avx512bw")))
+inline size_t findStructuralsAvx512(const char* data, size_t size, char delimiter, uint32_t* out) {
+    const __m512i delim = _mm512_set1_epi8(delimiter);
+    const __m512i newline = _mm512_set1_epi8('\n');
+
+    size_t n = 0;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __m512i x = _mm512_loadu_si512(data + i);
+        __mmask64 hit = _mm512_cmpeq_epi8_mask(x, delim) | _mm512_cmpeq_epi8_mask(x, newline);
+        n = appendPositions(hit, static_cast<uint32_t>(i), out, n);
+    }
+    if (i < size) {
+        __mmask64 tail = (1ULL << (size - i)) - 1; // size - i < 64
+        __m512i x = _mm512_maskz_loadu_epi8(tail, data + i);
+        __mmask64 hit = (_mm512_cmpeq_epi8_mask(x, delim) | _mm512_cmpeq_epi8_mask(x, newline)) & tail;
+        n = appendPositions(hit, static_cast<uint32_t>(i), out, n);
+    }
+    return n;
+}
+
+#endif // CSV_PARSER_X86
+
+using StructuralKernel = size_t (*)(const char*, size_t, char, uint32_t*);
+
+struct StructuralDispatch {
+    StructuralKernel kernel;
+    const char* name;
+};
+
+inline StructuralDispatch selectStructuralKernel() {
+#ifdef CSV_PARSER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512bw")) return {findStructuralsAvx512, "AVX-512"};
+    if (__builtin_cpu_supports("avx2")) return {findStructuralsAvx2, "AVX2"};
+    if (__builtin_cpu_supports("sse2")) return {findStructuralsSse2, "SSE2"};
+#endif
+    return {findStructuralsScalar, "scalar"};
+}
+
+// Chosen once, on first use
+inline const StructuralDispatch& structuralDispatch() {
+    static const StructuralDispatch dispatch = selectStructuralKernel();
+    return dispatch;
+}
+
+// Splits text into rows of string_view fields. Holds only the index
+// buffer, so keep one per thread and reuse it.
+class CsvParser {
+    StructuralKernel kernel;
+    char delimiter;
+    size_t window = 64 * 1024;
+    std::unique_ptr<uint32_t[]> structurals;
+
+public:
+    explicit CsvParser(char delimiter = ',', StructuralKernel kernel = structuralDispatch().kernel)
+        : kernel(kernel), delimiter(delimiter), structurals(new uint32_t[window]) {}
+
+    // Calls onRow(const std::string_view* fields, size_t count) for each
+    // row of `text`. Only the first MaxFields fields are stored, but
+    // `count` is the row's real field count.
+    template<size_t MaxFields, typename OnRow>
+    void forEachRow(std::string_view text, OnRow&& onRow) {
+        std::array<std::string_view, MaxFields> fields;
+        size_t count = 0;
+        size_t start = 0;
+
+        auto endField = [&](size_t begin, size_t end) {
+            if (count < MaxFields) fields[count] = text.substr(begin, end - begin);
+            ++count;
+        };
+        auto endRow = [&]() {
+            std::string_view& last = fields[std::min(count, MaxFields) - 1];
+            if (!last.empty() && last.back() == '\r') last.remove_suffix(1);
+            onRow(static_cast<const std::string_view*>(fields.data()), count);
+            count = 0;
+        };
+
+        while (start < text.size()) {
+            size_t length = std::min(window, text.size() - start);
+            bool last_window = start + length == text.size();
+            size_t found = kernel(text.data() + start, length, delimiter, structurals.get());
+
+            // Stop after the window's last line end; the rest is rescanned
+            size_t usable = found;
+            if (!last_window) {
+                while (usable > 0 && text[start + structurals[usable - 1]] != '\n') --usable;
+                if (usable == 0) {
+                    // A line longer than the window
+                    window *= 2;
+                    structurals.reset(new uint32_t[window]);
+                    continue;
+                }
+            }
+
+            size_t field_begin = start;
+            for (size_t k = 0; k < usable; ++k) {
+                size_t at = start + structurals[k];
+                if (text[at] == '\n' && count == 0 && at == field_begin) { // blank line
+                    field_begin = at + 1;
+                    continue;
+                }
+                endField(field_begin, at);
+                field_begin = at + 1;
+                if (text[at] == '\n') endRow();
+            }
+
+            if (last_window && (count > 0 || field_begin < text.size())) {
+                endField(field_begin, text.size());
+                endRow();
+                field_begin = text.size();
+            }
+            start = field_begin;
+        }
+    }
+};
+
+// `name,age,phone` rows as columns. Offsets point into `source`.
+struct PersonBatch {
+    std::string_view source;
+    std::vector<uint32_t> name_offset;
+    std::vector<uint32_t> name_length;
+    std::vector<uint32_t> age;
+    std::vector<uint32_t> phone_offset;
+    std::vector<uint32_t> phone_length;
+    uint64_t rejected = 0; // wrong field count, or age not a number that fits uint32_t
+
+    size_t size() const { return age.size(); }
+
+    std::string_view name(size_t i) const { return source.substr(name_offset[i], name_length[i]); }
+    std::string_view phone(size_t i) const { return source.substr(phone_offset[i], phone_length[i]); }
+
+    void reset(std::string_view text) {
+        source = text;
+        name_offset.clear();
+        name_length.clear();
+        age.clear();
+        phone_offset.clear();
+        phone_length.clear();
+        rejected = 0;
+    }
+};
+
+// Parses every row of `text` into `batch` (reset first). The batch
+// borrows `text`, so it must outlive the batch's use.
+inline void parsePeople(CsvParser& parser, std::string_view text, PersonBatch& batch) {
+    if (text.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("PersonBatch text must be under 4 GiB");
+    }
+    batch.reset(text);
+
+    parser.forEachRow<3>(text, [&](const std::string_view* fields, size_t count) {
+        if (count != 3 || fields[1].empty()) {
+            ++batch.rejected;
+            return;
+        }
+        uint32_t age = 0;
+        const char* age_end = fields[1].data() + fields[1].size();
+        auto [ptr, ec] = std::from_chars(fields[1].data(), age_end, age);
+        if (ec != std::errc{} || ptr != age_end) { // out of range, or not all digits
+            ++batch.rejected;
+            return;
+        }
+        batch.name_offset.push_back(static_cast<uint32_t>(fields[0].data() - text.data()));
+        batch.name_length.push_back(static_cast<uint32_t>(fields[0].size()));
+        batch.age.push_back(age);
+        batch.phone_offset.push_back(static_cast<uint32_t>(fields[2].data() - text.data()));
+        batch.phone_length.push_back(static_cast<uint32_t>(fields[2].size()));
+    });
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "cacheLine.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+// =============================================
+// Double-Mapped ("Magic") SPSC Byte Ring
+// =============================================
+// The same physical pages are mapped twice, back to back:
+//
+//     virtual:  [ page 0 .. page N-1 ][ page 0 .. page N-1 ]
+//
+// so byte `capacity + i` aliases byte `i`. Any run of up to `capacity`
+// bytes starting anywhere in the first copy is contiguous in virtual
+// memory, which means read(), write(), memchr() or a parser can work
+// straight on ring memory without splitting at the wrap point.
+//
+// Capacity is rounded up to a multiple of the page size. head/tail are
+// free-running byte counters, so all `capacity` bytes are usable. The
+// span calls are made once per batch, so they always read the peer's
+// index fresh instead of caching it like SpscRingBuffer.
+//
+// Producer: writable() -> fill -> produce(n)
+// Consumer: readable() -> use  -> consume(n)
+class DoubleMappedRingBuffer {
+    char* base = nullptr;
+    size_t size = 0;
+
+    // Producer-owned line
+    alignas(cacheLineSize) std::atomic<uint64_t> head{0};
+
+    // Consumer-owned line
+    alignas(cacheLineSize) std::atomic<uint64_t> tail{0};
+
+    static size_t roundUpToPages(size_t bytes) {
+        size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return bytes == 0 ? page : (bytes + page - 1) / page * page;
+    }
+
+public:
+    explicit DoubleMappedRingBuffer(size_t min_capacity) : size(roundUpToPages(min_capacity)) {
+        int fd = memfd_create("ring-buffer", MFD_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("memfd_create failed");
+        }
+        if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+            close(fd);
+            throw std::runtime_error("Failed to size ring buffer memory");
+        }
+
+        // Reserve 2 * size of address space, then map the file into both halves
+        void* area = mmap(nullptr, 2 * size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (area == MAP_FAILED) {
+            close(fd);
+            throw std::runtime_error("Failed to reserve ring buffer address space");
+        }
+        base = static_cast<char*>(area);
+
+        void* first = mmap(base, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        void* second = mmap(base + size, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+        close(fd); // the mappings keep the memory alive
+
+        if (first == MAP_FAILED || second == MAP_FAILED) {
+            munmap(base, 2 * size);
+            throw std::runtime_error("Failed to map ring buffer twice");
+        }
+    }
+
+    ~DoubleMappedRingBuffer() {
+        munmap(base, 2 * size);
+    }
+
+    DoubleMappedRingBuffer(const DoubleMappedRingBuffer&) = delete;
+    DoubleMappedRingBuffer& operator=(const DoubleMappedRingBuffer&) = delete;
+
+    size_t capacity() const { return size; }
+
+    // Producer only: every free byte, as one contiguous span
+    std::span<char> writable() {
+        uint64_t h = head.load(std::memory_order_relaxed);
+        uint64_t t = tail.load(std::memory_order_acquire);
+        return {base + (h % size), static_cast<size_t>(size - (h - t))};
+    }
+
+    // Producer only: publish `n` bytes written into writable()
+    void produce(size_t n) {
+        head.store(head.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    // Consumer only: every unread byte, as one contiguous span. The
+    // bytes belong to the consumer until consume(), so it may also
+    // transform them in place.
+    std::span<char> readable() {
+        uint64_t t = tail.load(std::memory_order_relaxed);
+        uint64_t h = head.load(std::memory_order_acquire);
+        return {base + (t % size), static_cast<size_t>(h - t)};
+    }
+
+    // Consumer only: hand `n` bytes from readable() back to the producer
+    void consume(size_t n) {
+        tail.store(tail.load(std::memory_order_relaxed) + n, std::memory_order_release);
+    }
+
+    // Copying conveniences built on the span API
+    size_t write(std::span<const char> bytes) {
+        auto free_space = writable();
+        size_t n = std::min(bytes.size(), free_space.size());
+        std::copy_n(bytes.data(), n, free_space.data());
+        produce(n);
+        return n;
+    }
+
+    size_t read(std::span<char> out) {
+        auto data = readable();
+        size_t n = std::min(out.size(), data.size());
+        std::copy_n(data.data(), n, out.data());
+        consume(n);
+        return n;
+    }
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// =============================================
+// Futex Wait / Wake on a 32-bit Atomic
+// =============================================
+// std::atomic::wait has no timeout, so the blocking buffers talk to
+// the kernel directly. `shared` selects the process-shared futex,
+// needed when the word lives in shared memory.
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "futex word must be a plain 32-bit integer");
+
+// Sleeps while `word` == `expected`, for at most `timeout`.
+// Returns early on wake-up, on a value change, or spuriously.
+inline void futexWait(std::atomic<uint32_t>& word, uint32_t expected,
+                      std::chrono::nanoseconds timeout, bool shared = false) {
+#ifdef __linux__
+    if (timeout.count() <= 0) return;
+    auto secs = std::chrono::duration_cast<std::chrono::seconds>(timeout);
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(secs.count());
+    ts.tv_nsec = static_cast<long>((timeout - secs).count());
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+            shared ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+#else
+    (void)shared;
+    if (word.load(std::memory_order_acquire) == expected) {
+        std::this_thread::sleep_for(std::min(timeout, std::chrono::nanoseconds(50'000)));
+    }
+#endif
+}
+
+// Wakes up to `count` threads sleeping on `word`.
+inline void futexWake(std::atomic<uint32_t>& word, int count = INT_MAX, bool shared = false) {
+#ifdef __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word),
+            shared ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+#else
+    (void)word; (void)count; (void)shared;
+#endif
+}
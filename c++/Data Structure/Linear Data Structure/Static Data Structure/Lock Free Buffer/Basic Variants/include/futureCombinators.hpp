@@ -0,0 +1,179 @@
+#pragma once
+
+#include "blockPool.hpp"
+#include "poolFuture.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// =============================================
+// when_all / when_any over PoolFutures
+// =============================================
+//   auto all = when_all(std::move(futures));      // vector or a pack
+//   all.then([](std::vector<PoolFuture<int>> ready) { ... });
+//   auto any = when_any(std::move(a), std::move(b));
+//   any.then([](WhenAnyResult<std::tuple<PoolFuture<int>, PoolFuture<int>>> r) { ... });
+// As in the Concurrency TS, the inputs are moved into the result and
+// come back through it, ready (when_all) or with `index` naming the
+// first one to become ready (when_any). Exceptions stay in the inputs,
+// so get() on each shows what failed. when_any of nothing is ready at
+// once, with index -1.
+//
+// Nothing waits. Each input gets a continuation (poolFuture.hpp) that
+// only counts it off, on the thread that completes it. The input that
+// settles the result also completes the result's future, and that
+// future's own then() is posted to the first input's executor. So a
+// fan-in costs one small continuation per input and no parked thread.
+
+template<typename Sequence>
+struct WhenAnyResult {
+    size_t index;
+    Sequence futures;
+};
+
+template<typename T, typename Fn>
+void forEachFuture(std::vector<PoolFuture<T>>& futures, Fn&& fn) {
+    for (size_t i = 0; i < futures.size(); ++i) fn(futures[i], i);
+}
+
+template<typename... Ts, typename Fn>
+void forEachFuture(std::tuple<PoolFuture<Ts>...>& futures, Fn&& fn) {
+    [&]<size_t... I>(std::index_sequence<I...>) {
+        (fn(std::get<I>(futures), I), ...);
+    }(std::index_sequence_for<Ts...>{});
+}
+
+template<typename T>
+FutureExecutor firstExecutor(const std::vector<PoolFuture<T>>& futures) {
+    return futures.empty() ? FutureExecutor{} : FutureAccess::executor(futures.front());
+}
+
+template<typename... Ts>
+FutureExecutor firstExecutor(const std::tuple<PoolFuture<Ts>...>& futures) {
+    if constexpr (sizeof...(Ts) == 0) {
+        return {};
+    } else {
+        return FutureAccess::executor(std::get<0>(futures));
+    }
+}
+
+// Completes `result` with the inputs once every one of them is ready
+template<typename Sequence>
+class WhenAllState {
+    Sequence futures;
+    FutureState<Sequence>* result;
+    std::atomic<size_t> remaining; // inputs, plus one for the caller
+
+    void arrive() {
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+        result->complete([this]() { return std::move(futures); });
+        poolDelete(this);
+    }
+
+public:
+    WhenAllState(Sequence futures, FutureState<Sequence>* result, size_t count)
+        : futures(std::move(futures)), result(result), remaining(count + 1) {}
+
+    // The caller's part: hooks up every input, then counts itself off
+    void start() {
+        forEachFuture(futures, [this](auto& future, size_t) {
+            FutureAccess::state(future)->onReady(poolNew<FutureContinuation>([this] { arrive(); }, FutureExecutor{}));
+        });
+        arrive();
+    }
+};
+
+// Completes `result` when the first input is ready. The winner and the
+// caller meet at `gate`, so the inputs are not moved out while the
+// caller is still hooking them up; the state is freed once every input
+// has reported.
+template<typename Sequence>
+class WhenAnyState {
+    Sequence futures;
+    FutureState<WhenAnyResult<Sequence>>* result;
+    std::atomic<size_t> refs; // inputs, plus one for the caller
+    std::atomic<bool> decided{false};
+    std::atomic<uint32_t> gate{0};
+    size_t winner = 0;
+
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) poolDelete(this);
+    }
+
+    void pass() {
+        if (gate.fetch_add(1, std::memory_order_acq_rel) != 1) return;
+        result->complete([this]() { return WhenAnyResult<Sequence>{winner, std::move(futures)}; });
+    }
+
+    void arrive(size_t index) {
+        if (!decided.exchange(true, std::memory_order_acq_rel)) {
+            winner = index;
+            pass();
+        }
+        release();
+    }
+
+public:
+    WhenAnyState(Sequence futures, FutureState<WhenAnyResult<Sequence>>* result, size_t count)
+        : futures(std::move(futures)), result(result), refs(count + 1) {}
+
+    void start() {
+        forEachFuture(futures, [this](auto& future, size_t index) {
+            FutureAccess::state(future)->onReady(
+                poolNew<FutureContinuation>([this, index] { arrive(index); }, FutureExecutor{}));
+        });
+        pass();
+        release();
+    }
+};
+
+template<typename Sequence>
+PoolFuture<Sequence> whenAllOf(Sequence futures, size_t count) {
+    forEachFuture(futures, [](auto& future, size_t) { FutureAccess::state(future); }); // all valid
+    FutureExecutor executor = firstExecutor(futures);
+    auto* result = poolNew<FutureState<Sequence>>();
+    poolNew<WhenAllState<Sequence>>(std::move(futures), result, count)->start();
+    return PoolFuture<Sequence>(result, executor);
+}
+
+template<typename Sequence>
+PoolFuture<WhenAnyResult<Sequence>> whenAnyOf(Sequence futures, size_t count) {
+    using Result = WhenAnyResult<Sequence>;
+    forEachFuture(futures, [](auto& future, size_t) { FutureAccess::state(future); });
+    FutureExecutor executor = firstExecutor(futures);
+    auto* result = poolNew<FutureState<Result>>();
+    if (count == 0) {
+        result->complete([&]() { return Result{static_cast<size_t>(-1), std::move(futures)}; });
+    } else {
+        poolNew<WhenAnyState<Sequence>>(std::move(futures), result, count)->start();
+    }
+    return PoolFuture<Result>(result, executor);
+}
+
+// A future of all the inputs, once each is ready
+template<typename T>
+PoolFuture<std::vector<PoolFuture<T>>> when_all(std::vector<PoolFuture<T>> futures) {
+    size_t count = futures.size();
+    return whenAllOf(std::move(futures), count);
+}
+
+template<typename... Ts>
+PoolFuture<std::tuple<PoolFuture<Ts>...>> when_all(PoolFuture<Ts>&&... futures) {
+    return whenAllOf(std::tuple<PoolFuture<Ts>...>(std::move(futures)...), sizeof...(Ts));
+}
+
+// A future of all the inputs and which one was ready first
+template<typename T>
+PoolFuture<WhenAnyResult<std::vector<PoolFuture<T>>>> when_any(std::vector<PoolFuture<T>> futures) {
+    size_t count = futures.size();
+    return whenAnyOf(std::move(futures), count);
+}
+
+template<typename... Ts>
+PoolFuture<WhenAnyResult<std::tuple<PoolFuture<Ts>...>>> when_any(PoolFuture<Ts>&&... futures) {
+    return whenAnyOf(std::tuple<PoolFuture<Ts>...>(std::move(futures)...), sizeof...(Ts));
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// =============================================
+// Move-Only Task with Inline Storage
+// =============================================
+// A void() callable like std::function, minus its costs for a task
+// that runs exactly once:
+//  * move-only, so lambdas may capture unique_ptrs, promises, etc.;
+//  * callables up to `Capacity` bytes (and nothrow-movable) live in
+//    the object itself, with no heap allocation; larger ones fall back
+//    to one `new`;
+//  * dispatch goes through one static table of three function
+//    pointers per callable type (invoke / move / destroy).
+// The default capacity makes the whole task one cache line.
+template<size_t Capacity = 48>
+class InlineFunction {
+    struct Ops {
+        void (*invoke)(void* storage);
+        void (*move)(void* from, void* to); // move-constructs into `to`, destroys `from`
+        void (*destroy)(void* storage);
+    };
+
+    template<typename Fn>
+    static constexpr bool stored_inline = sizeof(Fn) <= Capacity &&
+                                          alignof(Fn) <= alignof(std::max_align_t) &&
+                                          std::is_nothrow_move_constructible_v<Fn>;
+
+    template<typename Fn>
+    static constexpr Ops inline_ops{
+        [](void* s) { (*std::launder(static_cast<Fn*>(s)))(); },
+        [](void* from, void* to) {
+            Fn* source = std::launder(static_cast<Fn*>(from));
+            ::new (to) Fn(std::move(*source));
+            source->~Fn();
+        },
+        [](void* s) { std::launder(static_cast<Fn*>(s))->~Fn(); },
+    };
+
+    // Storage holds a Fn*
+    template<typename Fn>
+    static constexpr Ops heap_ops{
+        [](void* s) { (**static_cast<Fn**>(s))(); },
+        [](void* from, void* to) { ::new (to) Fn*(*static_cast<Fn**>(from)); },
+        [](void* s) { delete *static_cast<Fn**>(s); },
+    };
+
+    alignas(std::max_align_t) unsigned char storage[Capacity];
+    const Ops* ops = nullptr;
+
+    void reset() {
+        if (ops) {
+            ops->destroy(storage);
+            ops = nullptr;
+        }
+    }
+
+public:
+    static constexpr size_t capacity = Capacity;
+
+    InlineFunction() = default;
+
+    template<typename F, typename Fn = std::decay_t<F>,
+             typename = std::enable_if_t<!std::is_same_v<Fn, InlineFunction>>>
+    InlineFunction(F&& fn) {
+        if constexpr (stored_inline<Fn>) {
+            ::new (static_cast<void*>(storage)) Fn(std::forward<F>(fn));
+            ops = &inline_ops<Fn>;
+        } else {
+            ::new (static_cast<void*>(storage)) Fn*(new Fn(std::forward<F>(fn)));
+            ops = &heap_ops<Fn>;
+        }
+    }
+
+    InlineFunction(InlineFunction&& other) noexcept : ops(other.ops) {
+        if (ops) {
+            ops->move(other.storage, storage);
+            other.ops = nullptr;
+        }
+    }
+
+    InlineFunction& operator=(InlineFunction&& other) noexcept {
+        if (this != &other) {
+            reset();
+            ops = other.ops;
+            if (ops) {
+                ops->move(other.storage, storage);
+                other.ops = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    InlineFunction(const InlineFunction&) = delete;
+    InlineFunction& operator=(const InlineFunction&) = delete;
+
+    ~InlineFunction() { reset(); }
+
+    explicit operator bool() const { return ops != nullptr; }
+
+    void operator()() { ops->invoke(storage); }
+
+    // Whether a callable of this type avoids the heap
+    template<typename F>
+    static constexpr bool fitsInline() { return stored_inline<std::decay_t<F>>; }
+};
+
+using InlineTask = InlineFunction<>;
@@ -0,0 +1,314 @@
+#pragma once
+
+#include "bufferStats.hpp"
+#include "ringCopy.hpp"
+#include "ringStorage.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =============================================
+// Basic SPSC Lock-Free Buffer (see waitingBuffer.cpp)
+// =============================================
+// Any Size works (indices wrap with %), Size - 1 usable slots.
+// Slots are raw storage, as in LockFreeRingBuffer: only live elements
+// are constructed, and T may be move-only.
+// Stats = BufferStats turns on occupancy / residency instrumentation
+// (see bufferStats.hpp); the default compiles it out.
+template<typename T, size_t Size, typename Stats = NoBufferStats>
+class LockFreeBuffer {
+private:
+    RingStorage<T> buffer;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<uint64_t> popped{0}; // free-running, epoch for snapshot()
+    [[no_unique_address]] Stats counters{Size};
+
+    template<typename InputIt>
+    size_t pushRun(InputIt items, size_t count);
+    void advanceTail(size_t current_tail, size_t n);
+
+public:
+    LockFreeBuffer();
+    ~LockFreeBuffer();
+
+    template<typename... Args>
+    bool emplace(Args&&... args);
+    bool push(const T& item);
+    bool push(T&& item);
+    bool pop(T& item);
+    std::optional<T> pop();
+    bool isEmpty() const;
+
+    // Batched forms: transfer as many elements as fit / are available,
+    // publish head or tail once, and return how many were moved.
+    size_t push_n(std::span<const T> items);
+    size_t push_n_move(std::span<T> items);
+    size_t pop_n(std::span<T> out);
+
+    // Zero-copy slot access: claimRaw/commitRaw on the producer,
+    // peek/release on the consumer (see LockFreeRingBuffer for the full
+    // contract). The slot is raw storage to construct a T in, hence not
+    // the T* claim() of SpscRingBuffer.
+    void* claimRaw();
+    void commitRaw();
+    T* peek();
+    void release();
+
+    // Observer side, for a third (monitoring) thread: copy what is in
+    // the buffer without taking a lock or slowing either side down.
+    //
+    // A slot between tail and head only changes once it has been
+    // popped and the producer has come round to it, so the copy is
+    // validated seqlock-style against `popped`: read the epoch, copy
+    // tail..head, read the epoch again; unchanged means every slot was
+    // read while still live. If pops keep landing mid-copy, it retries
+    // up to `attempts` times and then keeps only the items that stayed
+    // in the buffer through the last copy, returning false.
+    //
+    // Needs a trivially copyable T (a torn copy is discarded, never
+    // used), and the consumer must not modify slots through peek().
+    bool snapshot(std::vector<T>& out, int attempts = 16) const
+        requires std::is_trivially_copyable_v<T>;
+
+    // Oldest item, without taking it; false if empty
+    bool peekOldest(T& item) const
+        requires std::is_trivially_copyable_v<T>;
+
+    BufferStatsSnapshot stats() const requires Stats::enabled {
+        return counters.snapshot();
+    }
+};
+
+template<typename T, size_t Size, typename Stats>
+LockFreeBuffer<T, Size, Stats>::LockFreeBuffer() :
+    buffer(Size),
+    head(0),
+    tail(0)
+{
+}
+
+template<typename T, size_t Size, typename Stats>
+LockFreeBuffer<T, Size, Stats>::~LockFreeBuffer() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+        size_t current_head = head.load(std::memory_order_acquire);
+        for (size_t i = tail.load(std::memory_order_relaxed); i != current_head; i = (i + 1) % Size) {
+            buffer.destroy(i);
+        }
+    }
+}
+
+template<typename T, size_t Size, typename Stats>
+template<typename... Args>
+bool LockFreeBuffer<T, Size, Stats>::emplace(Args&&... args) {
+    size_t current_head = head.load(std::memory_order_relaxed);
+    size_t next_head = (current_head + 1) % Size;
+    size_t current_tail = tail.load(std::memory_order_acquire);
+
+    if (next_head == current_tail) {
+        counters.onPushFull();
+        return false; // Buffer is full
+    }
+
+    buffer.construct(current_head, std::forward<Args>(args)...);
+    counters.onPush(current_head, 1, (next_head + Size - current_tail) % Size);
+    head.store(next_head, std::memory_order_release);
+    return true;
+}
+
+template<typename T, size_t Size, typename Stats>
+bool LockFreeBuffer<T, Size, Stats>::push(const T& item) {
+    return emplace(item);
+}
+
+template<typename T, size_t Size, typename Stats>
+bool LockFreeBuffer<T, Size, Stats>::push(T&& item) {
+    return emplace(std::move(item));
+}
+
+template<typename T, size_t Size, typename Stats>
+bool LockFreeBuffer<T, Size, Stats>::pop(T& item) {
+    size_t current_tail = tail.load(std::memory_order_relaxed);
+
+    if (current_tail == head.load(std::memory_order_acquire)) {
+        counters.onPopEmpty();
+        return false; // Buffer is empty
+    }
+
+    item = std::move(buffer[current_tail]);
+    buffer.destroy(current_tail);
+    counters.onPop(current_tail, 1);
+    advanceTail(current_tail, 1);
+    return true;
+}
+
+template<typename T, size_t Size, typename Stats>
+std::optional<T> LockFreeBuffer<T, Size, Stats>::pop() {
+    size_t current_tail = tail.load(std::memory_order_relaxed);
+
+    if (current_tail == head.load(std::memory_order_acquire)) {
+        counters.onPopEmpty();
+        return std::nullopt; // Buffer is empty
+    }
+
+    std::optional<T> item(std::move(buffer[current_tail]));
+    buffer.destroy(current_tail);
+    counters.onPop(current_tail, 1);
+    advanceTail(current_tail, 1);
+    return item;
+}
+
+template<typename T, size_t Size, typename Stats>
+bool LockFreeBuffer<T, Size, Stats>::isEmpty() const {
+    return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+}
+
+template<typename T, size_t Size, typename Stats>
+template<typename InputIt>
+size_t LockFreeBuffer<T, Size, Stats>::pushRun(InputIt items, size_t count) {
+    size_t current_head = head.load(std::memory_order_relaxed);
+    size_t current_tail = tail.load(std::memory_order_acquire);
+    size_t free_slots = (current_tail + Size - current_head - 1) % Size;
+
+    size_t n = std::min(count, free_slots);
+    if (n == 0) {
+        if (free_slots == 0) counters.onPushFull();
+        return 0;
+    }
+
+    constructIntoRing(items, n, buffer.data(), current_head, Size);
+    counters.onPush(current_head, n, Size - 1 - free_slots + n);
+    head.store((current_head + n) % Size, std::memory_order_release);
+    return n;
+}
+
+template<typename T, size_t Size, typename Stats>
+size_t LockFreeBuffer<T, Size, Stats>::push_n(std::span<const T> items) {
+    return pushRun(items.begin(), items.size());
+}
+
+template<typename T, size_t Size, typename Stats>
+size_t LockFreeBuffer<T, Size, Stats>::push_n_move(std::span<T> items) {
+    return pushRun(std::make_move_iterator(items.begin()), items.size());
+}
+
+template<typename T, size_t Size, typename Stats>
+size_t LockFreeBuffer<T, Size, Stats>::pop_n(std::span<T> out) {
+    size_t current_tail = tail.load(std::memory_order_relaxed);
+    size_t current_head = head.load(std::memory_order_acquire);
+    size_t available = (current_head + Size - current_tail) % Size;
+
+    size_t n = std::min(out.size(), available);
+    if (n == 0) {
+        if (available == 0) counters.onPopEmpty();
+        return 0;
+    }
+
+    relocateOutOfRing(buffer.data(), current_tail, n, Size, out.begin());
+    counters.onPop(current_tail, n);
+    advanceTail(current_tail, n);
+    return n;
+}
+
+template<typename T, size_t Size, typename Stats>
+void* LockFreeBuffer<T, Size, Stats>::claimRaw() {
+    size_t current_head = head.load(std::memory_order_relaxed);
+
+    if ((current_head + 1) % Size == tail.load(std::memory_order_acquire)) {
+        counters.onPushFull();
+        return nullptr; // Buffer is full
+    }
+    return buffer.data() + current_head;
+}
+
+template<typename T, size_t Size, typename Stats>
+void LockFreeBuffer<T, Size, Stats>::commitRaw() {
+    size_t current_head = head.load(std::memory_order_relaxed);
+    size_t next_head = (current_head + 1) % Size;
+    if constexpr (Stats::enabled) {
+        size_t current_tail = tail.load(std::memory_order_relaxed);
+        counters.onPush(current_head, 1, (next_head + Size - current_tail) % Size);
+    }
+    head.store(next_head, std::memory_order_release);
+}
+
+template<typename T, size_t Size, typename Stats>
+T* LockFreeBuffer<T, Size, Stats>::peek() {
+    size_t current_tail = tail.load(std::memory_order_relaxed);
+
+    if (current_tail == head.load(std::memory_order_acquire)) {
+        counters.onPopEmpty();
+        return nullptr; // Buffer is empty
+    }
+    return &buffer[current_tail];
+}
+
+template<typename T, size_t Size, typename Stats>
+void LockFreeBuffer<T, Size, Stats>::release() {
+    size_t current_tail = tail.load(std::memory_order_relaxed);
+    buffer.destroy(current_tail);
+    counters.onPop(current_tail, 1);
+    advanceTail(current_tail, 1);
+}
+
+// The epoch is bumped before tail moves, so an observer that sees the
+// new tail (or a slot the producer reused after it) also sees the new epoch.
+template<typename T, size_t Size, typename Stats>
+void LockFreeBuffer<T, Size, Stats>::advanceTail(size_t current_tail, size_t n) {
+    popped.store(popped.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    tail.store((current_tail + n) % Size, std::memory_order_release);
+}
+
+template<typename T, size_t Size, typename Stats>
+bool LockFreeBuffer<T, Size, Stats>::snapshot(std::vector<T>& out, int attempts) const
+    requires std::is_trivially_copyable_v<T>
+{
+    size_t dropped = 0;
+    for (int attempt = 0; attempt < std::max(attempts, 1); ++attempt) {
+        uint64_t epoch = popped.load(std::memory_order_acquire);
+        size_t current_tail = tail.load(std::memory_order_acquire);
+        size_t current_head = head.load(std::memory_order_acquire);
+
+        out.clear();
+        for (size_t i = current_tail; i != current_head; i = (i + 1) % Size) {
+            out.push_back(buffer[i]);
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t moved = popped.load(std::memory_order_relaxed) - epoch;
+        if (moved == 0) return true;
+        dropped = moved;
+    }
+
+    // Items past the first `dropped` were never popped, so never reused
+    out.erase(out.begin(), out.begin() + std::min(dropped, out.size()));
+    return false;
+}
+
+template<typename T, size_t Size, typename Stats>
+bool LockFreeBuffer<T, Size, Stats>::peekOldest(T& item) const
+    requires std::is_trivially_copyable_v<T>
+{
+    while (true) {
+        uint64_t epoch = popped.load(std::memory_order_acquire);
+        size_t current_tail = tail.load(std::memory_order_acquire);
+        if (current_tail == head.load(std::memory_order_acquire)) {
+            return false; // Buffer is empty
+        }
+
+        T copy = buffer[current_tail];
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (popped.load(std::memory_order_relaxed) == epoch) {
+            item = copy;
+            return true;
+        }
+    }
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "bufferStats.hpp"
+#include "ringCopy.hpp"
+#include "ringStorage.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+// =============================================
+// Basic SPSC Lock-Free Ring Buffer (see main2.cpp)
+// =============================================
+// Slots are raw storage (see ringStorage.hpp): an element is
+// constructed in place by push/emplace and moved out and destroyed by
+// pop, so T need not be default-constructible or copyable, e.g.
+// std::unique_ptr works, and only live elements are ever constructed.
+//
+// Stats = BufferStats turns on occupancy / residency instrumentation
+// (see bufferStats.hpp); the default compiles it out.
+template<typename T, size_t Size, typename Stats = NoBufferStats>
+class LockFreeRingBuffer {
+    static_assert((Size & (Size - 1)) == 0, "Size must be a power of 2");
+
+    RingStorage<T> buffer;
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    [[no_unique_address]] Stats counters{Size};
+
+    template<typename InputIt>
+    size_t pushRun(InputIt items, size_t count) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t free_slots = (tail.load(std::memory_order_acquire) - h - 1) & (Size - 1);
+
+        size_t n = std::min(count, free_slots);
+        if (n == 0) {
+            if (free_slots == 0) counters.onPushFull();
+            return 0;
+        }
+
+        constructIntoRing(items, n, buffer.data(), h, Size);
+        counters.onPush(h, n, Size - 1 - free_slots + n);
+        head.store((h + n) & (Size - 1), std::memory_order_release);
+        return n;
+    }
+
+public:
+    LockFreeRingBuffer() : buffer(Size), head(0), tail(0) {}
+
+    // Destroys whatever is still in the buffer
+    ~LockFreeRingBuffer() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            size_t h = head.load(std::memory_order_acquire);
+            for (size_t t = tail.load(std::memory_order_relaxed); t != h; t = (t + 1) & (Size - 1)) {
+                buffer.destroy(t);
+            }
+        }
+    }
+
+    // Constructs the item in place from `args`; false if full
+    template<typename... Args>
+    bool emplace(Args&&... args) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t next = (h + 1) & (Size - 1);
+        size_t t = tail.load(std::memory_order_acquire);
+
+        if (next == t) {
+            counters.onPushFull();
+            return false; // buffer full
+        }
+
+        buffer.construct(h, std::forward<Args>(args)...);
+        counters.onPush(h, 1, (next - t) & (Size - 1));
+        head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T& item) { return emplace(item); }
+    bool push(T&& item) { return emplace(std::move(item)); }
+
+    bool pop(T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+
+        if (t == head.load(std::memory_order_acquire)) {
+            counters.onPopEmpty();
+            return false; // buffer empty
+        }
+
+        item = std::move(buffer[t]);
+        buffer.destroy(t);
+        counters.onPop(t, 1);
+        tail.store((t + 1) & (Size - 1), std::memory_order_release);
+        return true;
+    }
+
+    // Move-constructs the item out; no T needed on the caller's side
+    std::optional<T> pop() {
+        size_t t = tail.load(std::memory_order_relaxed);
+
+        if (t == head.load(std::memory_order_acquire)) {
+            counters.onPopEmpty();
+            return std::nullopt; // buffer empty
+        }
+
+        std::optional<T> item(std::move(buffer[t]));
+        buffer.destroy(t);
+        counters.onPop(t, 1);
+        tail.store((t + 1) & (Size - 1), std::memory_order_release);
+        return item;
+    }
+
+    // Batched forms: transfer as many elements as fit / are available,
+    // publish head or tail once, and return how many were moved.
+    size_t push_n(std::span<const T> items) {
+        return pushRun(items.begin(), items.size());
+    }
+
+    size_t push_n_move(std::span<T> items) {
+        return pushRun(std::make_move_iterator(items.begin()), items.size());
+    }
+
+    size_t pop_n(std::span<T> out) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t available = (head.load(std::memory_order_acquire) - t) & (Size - 1);
+
+        size_t n = std::min(out.size(), available);
+        if (n == 0) {
+            if (available == 0) counters.onPopEmpty();
+            return 0;
+        }
+
+        relocateOutOfRing(buffer.data(), t, n, Size, out.begin());
+        counters.onPop(t, n);
+        tail.store((t + n) & (Size - 1), std::memory_order_release);
+        return n;
+    }
+
+    // Zero-copy slot access. The producer constructs the next item
+    // directly in the slot:
+    //     if (void* slot = rb.claimRaw()) { new (slot) T(...); rb.commitRaw(); }
+    // and the consumer reads it where it lies:
+    //     if (T* item = rb.peek()) { use(*item); rb.release(); }
+    // claimRaw/peek return nullptr when full/empty. commitRaw must
+    // follow a successful claimRaw once a T has been constructed in the
+    // slot; release destroys the item. Both must run on the thread that
+    // claimed/peeked. The "Raw" sets these apart from the T* claim() of
+    // SpscRingBuffer and BroadcastRingBuffer, whose slots hold live
+    // objects to assign into.
+    void* claimRaw() {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (((h + 1) & (Size - 1)) == tail.load(std::memory_order_acquire)) {
+            counters.onPushFull();
+            return nullptr; // buffer full
+        }
+        return buffer.data() + h;
+    }
+
+    void commitRaw() {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t next = (h + 1) & (Size - 1);
+        if constexpr (Stats::enabled) {
+            counters.onPush(h, 1, (next - tail.load(std::memory_order_relaxed)) & (Size - 1));
+        }
+        head.store(next, std::memory_order_release);
+    }
+
+    T* peek() {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire)) {
+            counters.onPopEmpty();
+            return nullptr; // buffer empty
+        }
+        return &buffer[t];
+    }
+
+    void release() {
+        size_t t = tail.load(std::memory_order_relaxed);
+        buffer.destroy(t);
+        counters.onPop(t, 1);
+        tail.store((t + 1) & (Size - 1), std::memory_order_release);
+    }
+
+    bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    BufferStatsSnapshot stats() const requires Stats::enabled {
+        return counters.snapshot();
+    }
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// =============================================
+// Read-Only Memory-Mapped Input File
+// =============================================
+// The whole file as one std::string_view: no stream, no per-line
+// std::string, and any number of threads can read disjoint parts.
+class MappedFile {
+    const char* data = nullptr;
+    size_t size = 0;
+
+public:
+    explicit MappedFile(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open input file");
+        }
+
+        struct stat st {};
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            throw std::runtime_error("Failed to stat input file");
+        }
+        size = static_cast<size_t>(st.st_size);
+
+        if (size > 0) { // mmap rejects length 0
+            void* area = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (area == MAP_FAILED) {
+                close(fd);
+                throw std::runtime_error("Failed to map input file");
+            }
+            madvise(area, size, MADV_SEQUENTIAL); // read-ahead hint
+            data = static_cast<const char*>(area);
+        }
+        close(fd); // the mapping keeps the file open
+    }
+
+    ~MappedFile() {
+        if (data) munmap(const_cast<char*>(data), size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::string_view view() const { return {data, size}; }
+};
+
+// =============================================
+// Line-Aligned Split of a Text into N Ranges
+// =============================================
+// Range k starts just after the first '\n' at or past k * size / N and
+// ends where range k + 1 starts, so ranges are disjoint, cover the
+// whole text, and never cut a line. Each boundary is found with one
+// memchr from its own guess, so threads can compute their ranges
+// independently without a shared pass over the text. A line longer
+// than a range leaves some ranges empty.
+class LineRanges {
+    std::string_view text;
+    size_t parts;
+
+    size_t boundary(size_t k) const {
+        if (k == 0) return 0;
+        if (k >= parts) return text.size();
+
+        size_t guess = text.size() / parts * k + text.size() % parts * k / parts;
+        const void* newline = std::memchr(text.data() + guess, '\n', text.size() - guess);
+        return newline ? static_cast<const char*>(newline) - text.data() + 1 : text.size();
+    }
+
+public:
+    LineRanges(std::string_view text, size_t parts) : text(text), parts(parts == 0 ? 1 : parts) {}
+
+    size_t size() const { return parts; }
+
+    std::string_view operator[](size_t k) const {
+        size_t begin = boundary(k);
+        size_t end = boundary(k + 1);
+        return begin < end ? text.substr(begin, end - begin) : std::string_view();
+    }
+};
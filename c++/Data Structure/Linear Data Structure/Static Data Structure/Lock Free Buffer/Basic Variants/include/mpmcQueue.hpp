@@ -0,0 +1,163 @@
+#pragma once
+
+#include "cacheLine.hpp"
+#include "waitStrategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+// =============================================
+// Bounded MPMC Lock-Free Queue
+// =============================================
+// Any number of producers and consumers. Every slot carries a sequence
+// number that tells a thread whether the slot is ready for it:
+//   sequence == pos          -> free, a producer at `pos` may fill it
+//   sequence == pos + 1      -> full, a consumer at `pos` may take it
+//   sequence == pos + cap    -> freed for the producer one lap ahead
+// Producers and consumers claim positions with a CAS on their own
+// counter, so they never contend with each other, only with threads on
+// the same side.
+//
+// push/pop/shutdown follow the ThreadSafeQueue contract from main.cpp:
+//   push blocks while full and returns false once shut down,
+//   pop blocks while empty and returns false once shut down and drained.
+// try_push/try_pop never block. A blocked push or pop spins and yields
+// per its WaitStrategy, then parks on a futex like BlockingRingBuffer,
+// one futex word per side; shutdown() wakes every parked thread. The
+// default spins only briefly: with several threads per side, a waiter
+// is more often behind a descheduled peer than a running one.
+template<typename T>
+class MpmcQueue {
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    size_t mask;
+    std::unique_ptr<Slot[]> slots;
+
+    alignas(cacheLineSize) std::atomic<size_t> enqueue_pos{0};
+    alignas(cacheLineSize) std::atomic<size_t> dequeue_pos{0};
+    alignas(cacheLineSize) std::atomic<bool> shutdown_flag{false};
+
+    WaitStrategy strategy;
+    alignas(cacheLineSize) std::atomic<uint32_t> pushEpoch{0}; // bumped when an item is added
+    std::atomic<uint32_t> consumersWaiting{0};
+    alignas(cacheLineSize) std::atomic<uint32_t> popEpoch{0};  // bumped when a slot is freed
+    std::atomic<uint32_t> producersWaiting{0};
+
+    static size_t roundUpToPowerOf2(size_t n) {
+        size_t size = 2;
+        while (size < n) size <<= 1;
+        return size;
+    }
+
+    // Moves from `item` only on success
+    bool tryPushImpl(T& item) {
+        Slot* slot;
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            slot = &slots[pos & mask];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // queue full
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->data = std::move(item);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        notifyWaiter(pushEpoch, consumersWaiting);
+        return true;
+    }
+
+public:
+    explicit MpmcQueue(size_t max_size = 10,
+                       WaitStrategy strategy = {std::chrono::microseconds(1), true, std::chrono::microseconds(100)})
+        : mask(roundUpToPowerOf2(max_size) - 1),
+          slots(new Slot[mask + 1]),
+          strategy(strategy) {
+        for (size_t i = 0; i <= mask; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    bool try_push(T item) {
+        return tryPushImpl(item);
+    }
+
+    bool try_pop(T& item) {
+        Slot* slot;
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        while (true) {
+            slot = &slots[pos & mask];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // queue empty
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        item = std::move(slot->data);
+        slot->sequence.store(pos + mask + 1, std::memory_order_release);
+        notifyWaiter(popEpoch, producersWaiting);
+        return true;
+    }
+
+    bool push(T item) {
+        bool pushed = false;
+        waitUntil([&]() { return is_shutdown() || (pushed = tryPushImpl(item)); }, popEpoch, producersWaiting,
+                  WaitClock::time_point::max(), strategy);
+        return pushed;
+    }
+
+    bool pop(T& item) {
+        bool popped = false;
+        waitUntil([&]() { return (popped = try_pop(item)) || is_shutdown(); }, pushEpoch, consumersWaiting,
+                  WaitClock::time_point::max(), strategy);
+        // A producer may have finished just before shutdown
+        return popped || try_pop(item);
+    }
+
+    void shutdown() {
+        shutdown_flag.store(true, std::memory_order_release);
+        for (std::atomic<uint32_t>* epoch : {&pushEpoch, &popEpoch}) {
+            epoch->fetch_add(1, std::memory_order_release);
+            futexWake(*epoch);
+        }
+    }
+
+    bool is_shutdown() const {
+        return shutdown_flag.load(std::memory_order_acquire);
+    }
+
+    // Approximate when called concurrently with push/pop
+    size_t size() const {
+        size_t head = enqueue_pos.load(std::memory_order_acquire);
+        size_t tail = dequeue_pos.load(std::memory_order_acquire);
+        return head > tail ? head - tail : 0;
+    }
+
+    size_t capacity() const { return mask + 1; }
+};
@@ -0,0 +1,271 @@
+#pragma once
+
+#include "blockPool.hpp"
+#include "cacheLine.hpp"
+#include "threadPool.hpp"
+#include "waitStrategy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =============================================
+// Data-Parallel Loops on the ThreadPool
+// =============================================
+//   parallel_for(pool, begin, end, [](Index i) { ... });
+//   T total = parallel_reduce(pool, begin, end, identity,
+//                             [](Index b, Index e, T acc) { ...; return acc; },
+//                             [](T a, T b) { return a + b; });
+//   parallel_invoke(pool, f, g, h);
+// `begin` and `end` must have the same integer type.
+//
+// Ranges are divided by lazy binary splitting. A thread holding a range
+// posts the upper half as a task only while its own deque is empty,
+// i.e. only while the other workers have stolen everything it had to
+// give. Otherwise it runs `grain` indices and looks again. The split
+// count thus adapts to how many threads are actually idle, and the
+// grain only bounds how small a piece may get. Left at 0 it becomes
+// size / (64 * threads), at least 1. A thread outside the pool cannot
+// be stolen from, so it splits down to size / (4 * threads) and works
+// on the last piece itself.
+//
+// The calling thread always does a share of the work. While it waits
+// for the rest it runs other queued tasks (ThreadPool::runPendingTask),
+// so calls nest: a pool task may call parallel_for without parking the
+// worker. When there is nothing left to run, it parks on a futex.
+//
+// There is no future per element or per chunk. One pooled ForkJoinState
+// per call counts the indices still to do. If the body throws, the
+// remaining chunks are skipped and the first exception is rethrown to
+// the caller once every task has finished.
+//
+// parallel_reduce keeps one partial result per thread, each on its own
+// cache line, and combines them at the end. Each piece is reduced into
+// a local value first and merged into the thread's partial afterwards:
+// a `reduce` that makes a nested parallel call may run other pieces of
+// the same reduction on its thread while it waits, and those merge
+// into the partial in the meantime. As with std::reduce, `combine` must
+// be associative and commutative, and `identity` must be its neutral
+// element.
+
+class ForkJoinState {
+    std::atomic<uint32_t> refs{1}; // the caller, plus one per posted task
+    std::atomic<size_t> remaining;
+    std::atomic<uint32_t> epoch{0};
+    std::atomic<uint32_t> waiting{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+
+public:
+    explicit ForkJoinState(size_t work) : remaining(work) {}
+
+    void retain() { refs.fetch_add(1, std::memory_order_relaxed); }
+
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) poolDelete(this);
+    }
+
+    // `count` units of work are finished (or skipped after a failure)
+    void done(size_t count) {
+        if (remaining.fetch_sub(count, std::memory_order_acq_rel) == count) notifyWaiter(epoch, waiting);
+    }
+
+    bool finished() const { return remaining.load(std::memory_order_acquire) == 0; }
+
+    // First failure wins; later chunks check this and skip their work
+    void fail(std::exception_ptr e) {
+        bool expected = false;
+        if (failed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) error = e;
+    }
+
+    bool hasFailed() const { return failed.load(std::memory_order_relaxed); }
+
+    // Caller only: helps the pool until everything is done, then
+    // rethrows the first failure
+    void join(ThreadPool& pool) {
+        int idle = 0;
+        while (!finished()) {
+            if (pool.runPendingTask()) {
+                idle = 0;
+            } else if (++idle < 64) {
+                cpuRelax();
+            } else {
+                // The rest is running elsewhere; check for new tasks every so often
+                waitUntil([this]() { return finished(); }, epoch, waiting, deadlineAfter(std::chrono::milliseconds(1)),
+                          WaitStrategy{std::chrono::nanoseconds(0), true});
+            }
+        }
+        if (failed.load(std::memory_order_acquire)) std::rethrow_exception(error);
+    }
+};
+
+// Runs leaf(b, e) over [begin, end) in pieces; see the top of the file
+template<typename Index, typename Leaf>
+class RangeSplitter {
+    ThreadPool& pool;
+    ForkJoinState* state;
+    const Leaf* leaf;
+    Index grain;
+
+    void runLeaf(Index begin, Index end) const {
+        if (!state->hasFailed()) {
+            try {
+                (*leaf)(begin, end);
+            } catch (...) {
+                state->fail(std::current_exception());
+            }
+        }
+        state->done(static_cast<size_t>(end - begin));
+    }
+
+    void postUpperHalf(Index begin, Index& end) const {
+        Index mid = begin + (end - begin) / 2;
+        state->retain();
+        pool.post([splitter = *this, mid, end]() {
+            splitter.split(mid, end);
+            splitter.state->release();
+        });
+        end = mid;
+    }
+
+public:
+    RangeSplitter(ThreadPool& pool, ForkJoinState* state, const Leaf* leaf, Index grain)
+        : pool(pool), state(state), leaf(leaf), grain(grain) {}
+
+    // On a worker: lazy binary splitting down to `grain`
+    void split(Index begin, Index end) const {
+        while (end - begin > grain && !state->hasFailed()) {
+            if (pool.localQueueDepth() == 0) {
+                postUpperHalf(begin, end);
+            } else {
+                runLeaf(begin, begin + grain);
+                begin += grain;
+            }
+        }
+        runLeaf(begin, end);
+    }
+
+    // Off the pool: eager halving down to `piece`, then the last piece here
+    void splitFromOutside(Index begin, Index end, Index piece) const {
+        while (end - begin > piece) postUpperHalf(begin, end);
+        runLeaf(begin, end);
+    }
+};
+
+template<typename Index, typename Leaf>
+void parallelRange(ThreadPool& pool, Index begin, Index end, Index grain, const Leaf& leaf) {
+    static_assert(std::is_integral_v<Index>, "parallel loops take integer indices");
+    if (end <= begin) return;
+
+    size_t size = static_cast<size_t>(end - begin);
+    size_t threads = std::max<size_t>(pool.size(), 1);
+    if (grain <= 0) grain = static_cast<Index>(std::max<size_t>(size / (64 * threads), 1));
+
+    ForkJoinState* state = poolNew<ForkJoinState>(size);
+    struct Release {
+        ForkJoinState* state;
+        ~Release() { state->release(); }
+    } release{state};
+
+    RangeSplitter<Index, Leaf> splitter(pool, state, &leaf, grain);
+    if (pool.workerIndex() >= 0) {
+        splitter.split(begin, end);
+    } else {
+        Index piece = static_cast<Index>(std::max<size_t>(size / (4 * threads), 1));
+        splitter.splitFromOutside(begin, end, std::max(piece, grain));
+    }
+    state->join(pool);
+}
+
+// body(i) for every i in [begin, end)
+template<typename Index, typename Body>
+void parallel_for(ThreadPool& pool, Index begin, Index end, const Body& body,
+                  std::type_identity_t<Index> grain = 0) {
+    parallelRange(pool, begin, end, grain, [&body](Index b, Index e) {
+        for (Index i = b; i < e; ++i) body(i);
+    });
+}
+
+// reduce(b, e, acc) folds [b, e) into acc and returns it; the partial
+// results are then merged with combine(x, y)
+template<typename Index, typename T, typename Reduce, typename Combine>
+T parallel_reduce(ThreadPool& pool, Index begin, Index end, T identity, const Reduce& reduce,
+                  const Combine& combine, std::type_identity_t<Index> grain = 0) {
+    struct alignas(cacheLineSize) Partial {
+        std::optional<T> value;
+
+        void merge(const Combine& combine, T piece) {
+            value = value ? combine(std::move(*value), std::move(piece)) : std::move(piece);
+        }
+    };
+    // One per worker and one for the caller, each only written by its
+    // own thread. Another outside thread that helps (see
+    // runPendingTask) shares the last one, under a lock.
+    std::vector<Partial> partials(pool.size() + 2);
+    Partial& caller = partials[pool.size()];
+    Partial& helpers = partials[pool.size() + 1];
+    std::mutex helpers_mutex;
+    const std::thread::id caller_id = std::this_thread::get_id();
+
+    parallelRange(pool, begin, end, grain, [&](Index b, Index e) {
+        T piece = reduce(b, e, identity);
+        int worker = pool.workerIndex();
+        if (worker >= 0) {
+            partials[static_cast<size_t>(worker)].merge(combine, std::move(piece));
+        } else if (std::this_thread::get_id() == caller_id) {
+            caller.merge(combine, std::move(piece));
+        } else {
+            std::lock_guard<std::mutex> lock(helpers_mutex);
+            helpers.merge(combine, std::move(piece));
+        }
+    });
+
+    T result = std::move(identity);
+    for (Partial& partial : partials) {
+        if (partial.value) result = combine(std::move(result), std::move(*partial.value));
+    }
+    return result;
+}
+
+// Runs every function, the first on the calling thread, and returns
+// when all have finished
+template<typename First, typename... Rest>
+void parallel_invoke(ThreadPool& pool, First&& first, Rest&&... rest) {
+    ForkJoinState* state = poolNew<ForkJoinState>(sizeof...(Rest) + 1);
+    struct Release {
+        ForkJoinState* state;
+        ~Release() { state->release(); }
+    } release{state};
+
+    auto guarded = [state](auto& fn) {
+        if (!state->hasFailed()) {
+            try {
+                fn();
+            } catch (...) {
+                state->fail(std::current_exception());
+            }
+        }
+        state->done(1);
+    };
+
+    (
+        [&] {
+            state->retain();
+            pool.post([state, guarded, fn = &rest]() {
+                guarded(*fn);
+                state->release();
+            });
+        }(),
+        ...);
+    guarded(first);
+    state->join(pool);
+}
@@ -0,0 +1,532 @@
+#pragma once
+
+#include "mpmcQueue.hpp"
+#include "reorderBuffer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =============================================
+// Multi-Stage Pipeline Engine
+// =============================================
+// ProducerConsumerManager's read -> upper-case -> write, generalized to
+// any chain of typed stages:
+//
+//   Pipeline pipeline;
+//   pipeline.source<Line>("read", readLine)               // std::optional<Line>()
+//           .stage<Record>("parse", StageMode::Parallel, 4, parse)
+//           .stage<Record>("filter", StageMode::Parallel, 2, keep)
+//           .sink("write", StageMode::SerialInOrder, 1, write);
+//   PipelineReport report = pipeline.run();
+//
+// Each stage declares how it wants its input:
+//   Parallel          `threads` workers, items in any order
+//   SerialOutOfOrder  one worker, items as they arrive
+//   SerialInOrder     one worker, items in the order the source made them
+// The source numbers every item. A stage is fed through a bounded
+// MpmcQueue, or through a ReorderBuffer if it is SerialInOrder, so
+// order is only paid for where it is asked for. A stage function
+// returns std::optional<Out>; nullopt drops the item (a filter). The
+// empty slot still travels on, so in-order stages see no gaps.
+//
+// The source never runs more than `capacity` items ahead of any
+// in-order stage. A ReorderBuffer window therefore cannot fill up with
+// late items while the one it waits for is stuck behind them.
+//
+// Each stage records items, drops, and time spent working, waiting for
+// input and waiting for room downstream (see PipelineReport). Threads
+// go where the bottleneck is: threads() sets one stage, balance()
+// spreads a total budget over the Parallel stages by the work each did
+// in an earlier run. run() may be called again after either.
+//
+// If a stage function throws, every queue is closed, the workers wind
+// down and run() rethrows the first exception.
+
+enum class StageMode { Parallel, SerialOutOfOrder, SerialInOrder };
+
+struct StageStats {
+    std::string name;
+    StageMode mode = StageMode::Parallel;
+    size_t threads = 1;
+    uint64_t items = 0;    // taken in (made, for the source)
+    uint64_t dropped = 0;  // stage function returned nullopt
+    std::chrono::nanoseconds busy{0};         // inside the stage function, all threads
+    std::chrono::nanoseconds input_wait{0};   // waiting for an item
+    std::chrono::nanoseconds output_wait{0};  // waiting for room downstream
+};
+
+struct PipelineReport {
+    std::chrono::nanoseconds wall{0};
+    std::vector<StageStats> stages;
+
+    // Busy share of the stage's threads over the run; the bottleneck
+    // is the stage closest to 1
+    double utilization(const StageStats& stage) const {
+        double available = static_cast<double>(wall.count()) * stage.threads;
+        return available > 0 ? stage.busy.count() / available : 0.0;
+    }
+
+    void print(std::ostream& out) const {
+        auto ms = [](std::chrono::nanoseconds d) { return d.count() / 1e6; };
+        out << std::fixed << std::setprecision(1) << "Pipeline ran " << ms(wall) << " ms\n"
+            << "  stage        threads      items    dropped   busy ms  in-wait ms  out-wait ms  util\n";
+        for (const auto& s : stages) {
+            out << "  " << std::left << std::setw(12) << s.name << std::right << std::setw(8) << s.threads
+                << std::setw(11) << s.items << std::setw(11) << s.dropped << std::setw(10) << ms(s.busy)
+                << std::setw(12) << ms(s.input_wait) << std::setw(13) << ms(s.output_wait) << std::setw(5)
+                << static_cast<int>(utilization(s) * 100) << "%\n";
+        }
+        out << std::defaultfloat;
+    }
+};
+
+// The link into one stage: a bounded MpmcQueue, or a ReorderBuffer for
+// a SerialInOrder stage. Many writers; one reader when in order.
+template<typename T>
+class PipelineChannel {
+public:
+    struct Item {
+        uint64_t sequence = 0;
+        std::optional<T> value;
+    };
+
+private:
+    std::unique_ptr<MpmcQueue<Item>> queue;
+    std::unique_ptr<ReorderBuffer<std::optional<T>>> ordered;
+    uint64_t next_ordered = 0;
+
+public:
+    PipelineChannel(bool in_order, size_t capacity) {
+        if (in_order) {
+            ordered = std::make_unique<ReorderBuffer<std::optional<T>>>(capacity);
+        } else {
+            queue = std::make_unique<MpmcQueue<Item>>(capacity);
+        }
+    }
+
+    // Blocks while full; false once closed
+    bool push(uint64_t sequence, std::optional<T> value) {
+        if (ordered) return ordered->insert(sequence, std::move(value));
+        return queue->push(Item{sequence, std::move(value)});
+    }
+
+    // Blocks while empty; false once closed and drained
+    bool pop(Item& item) {
+        if (ordered) {
+            if (!ordered->pop(item.value)) return false;
+            item.sequence = next_ordered++;
+            return true;
+        }
+        return queue->pop(item);
+    }
+
+    // In-order channels only make room as the reader moves on
+    bool waitForRoom(uint64_t sequence) const {
+        return !ordered || ordered->waitForRoom(sequence);
+    }
+
+    void close() {
+        if (ordered) {
+            ordered->close();
+        } else {
+            queue->shutdown();
+        }
+    }
+};
+
+class Pipeline;
+
+// Type-erased stage: the Pipeline only starts, stops and measures it
+class PipelineStage {
+    friend class Pipeline;
+
+protected:
+    using Clock = std::chrono::steady_clock;
+
+    struct Counters {
+        uint64_t items = 0;
+        uint64_t dropped = 0;
+        Clock::duration busy{0};
+        Clock::duration input_wait{0};
+        Clock::duration output_wait{0};
+    };
+
+    Pipeline& pipeline;
+    StageStats stats;
+    std::mutex stats_mutex;
+    std::atomic<size_t> active{0};
+
+    PipelineStage(Pipeline& pipeline, std::string name, StageMode mode, size_t threads) : pipeline(pipeline) {
+        stats.name = std::move(name);
+        stats.mode = mode;
+        stats.threads = mode == StageMode::Parallel ? std::max<size_t>(threads, 1) : 1;
+    }
+
+    void resetStats() {
+        stats.items = stats.dropped = 0;
+        stats.busy = stats.input_wait = stats.output_wait = std::chrono::nanoseconds(0);
+    }
+
+    // Workers add their totals once, when they finish
+    void record(const Counters& local) {
+        std::lock_guard<std::mutex> lock(stats_mutex);
+        stats.items += local.items;
+        stats.dropped += local.dropped;
+        stats.busy += std::chrono::duration_cast<std::chrono::nanoseconds>(local.busy);
+        stats.input_wait += std::chrono::duration_cast<std::chrono::nanoseconds>(local.input_wait);
+        stats.output_wait += std::chrono::duration_cast<std::chrono::nanoseconds>(local.output_wait);
+    }
+
+    // Fresh input channel, counters zeroed; called before every run
+    virtual void prepare(size_t capacity) = 0;
+    // One worker thread's loop
+    virtual void work() = 0;
+    virtual void closeInput() = 0;
+    virtual void closeOutput() = 0;
+    virtual bool waitForRoom(uint64_t sequence) const = 0;
+    virtual bool hasOutput() const = 0;
+
+    void worker();
+
+public:
+    virtual ~PipelineStage() = default;
+};
+
+template<typename In, typename Out, typename Fn>
+class TransformStage;
+template<typename In, typename Fn>
+class SinkStage;
+template<typename Out, typename Fn>
+class SourceStage;
+
+// Where a stage with output sends it: the next stage's input channel
+template<typename T>
+using PipelineOutput = std::unique_ptr<PipelineChannel<T>>*;
+
+// Builder handle for the end of the chain, carrying its item type
+template<typename T>
+class PipelineFlow {
+    Pipeline& pipeline;
+    PipelineOutput<T>* output; // the last stage's, set when the next stage is added
+
+public:
+    PipelineFlow(Pipeline& pipeline, PipelineOutput<T>* output) : pipeline(pipeline), output(output) {}
+
+    // fn: std::optional<Out>(T&&); nullopt drops the item
+    template<typename Out, typename Fn>
+    PipelineFlow<Out> stage(std::string name, StageMode mode, size_t threads, Fn fn);
+
+    // fn: void(T&&); ends the chain
+    template<typename Fn>
+    Pipeline& sink(std::string name, StageMode mode, size_t threads, Fn fn);
+};
+
+class Pipeline {
+    template<typename T>
+    friend class PipelineFlow;
+    friend class PipelineStage;
+    template<typename Out, typename Fn>
+    friend class SourceStage;
+
+    size_t capacity;
+    std::vector<std::unique_ptr<PipelineStage>> stages;
+
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex error_mutex;
+
+    template<typename Stage>
+    Stage& add(std::unique_ptr<Stage> stage) {
+        Stage& added = *stage;
+        stages.push_back(std::move(stage));
+        return added;
+    }
+
+    PipelineStage& find(const std::string& name) {
+        for (auto& stage : stages) {
+            if (stage->stats.name == name) return *stage;
+        }
+        throw std::runtime_error("No pipeline stage named " + name);
+    }
+
+    // First failure wins; closing every input unblocks every thread
+    void fail(std::exception_ptr e) {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex);
+            if (!error) error = e;
+        }
+        failed.store(true, std::memory_order_release);
+        for (auto& stage : stages) stage->closeInput();
+    }
+
+    // Source side: hold item `sequence` back until every in-order stage can take it
+    bool waitForRoom(uint64_t sequence) const {
+        for (auto& stage : stages) {
+            if (!stage->waitForRoom(sequence)) return false;
+        }
+        return true;
+    }
+
+public:
+    // `capacity`: slots per queue, and the reorder window
+    explicit Pipeline(size_t capacity = 64) : capacity(capacity) {}
+
+    Pipeline(const Pipeline&) = delete;
+    Pipeline& operator=(const Pipeline&) = delete;
+
+    // fn: std::optional<Out>(); nullopt ends the stream. Runs on one thread.
+    template<typename Out, typename Fn>
+    PipelineFlow<Out> source(std::string name, Fn fn) {
+        if (!stages.empty()) throw std::runtime_error("Pipeline already has a source");
+        auto& stage = add(std::make_unique<SourceStage<Out, Fn>>(*this, std::move(name), std::move(fn)));
+        return PipelineFlow<Out>(*this, &stage.output);
+    }
+
+    // Thread budget of one stage; Serial stages always run on one
+    Pipeline& threads(const std::string& name, size_t count) {
+        PipelineStage& stage = find(name);
+        if (count == 0) throw std::runtime_error("A stage needs at least one thread");
+        if (stage.stats.mode != StageMode::Parallel && count != 1) {
+            throw std::runtime_error("Stage " + name + " is serial and runs on one thread");
+        }
+        stage.stats.threads = count;
+        return *this;
+    }
+
+    // Spreads `total` threads: one per serial stage and the source, the
+    // rest over the Parallel stages in proportion to their busy time in
+    // `last`, at least one each (largest remainder rounding).
+    Pipeline& balance(size_t total, const PipelineReport& last) {
+        std::vector<PipelineStage*> parallel;
+        size_t fixed = 0;
+        for (auto& stage : stages) {
+            if (stage->stats.mode == StageMode::Parallel) {
+                parallel.push_back(stage.get());
+            } else {
+                ++fixed;
+            }
+        }
+        if (parallel.empty()) return *this;
+        size_t spare = total > fixed + parallel.size() ? total - fixed - parallel.size() : 0;
+
+        std::vector<double> weight(parallel.size(), 0.0);
+        double total_weight = 0;
+        for (size_t i = 0; i < parallel.size(); ++i) {
+            for (const auto& s : last.stages) {
+                if (s.name == parallel[i]->stats.name) weight[i] = static_cast<double>(s.busy.count());
+            }
+            total_weight += weight[i];
+        }
+
+        std::vector<std::pair<double, size_t>> remainders;
+        size_t given = 0;
+        for (size_t i = 0; i < parallel.size(); ++i) {
+            double share = total_weight > 0 ? spare * weight[i] / total_weight : 0.0;
+            size_t whole = static_cast<size_t>(share);
+            parallel[i]->stats.threads = 1 + whole;
+            given += whole;
+            remainders.push_back({share - whole, i});
+        }
+        std::sort(remainders.begin(), remainders.end(), std::greater<>());
+        for (size_t k = 0; given < spare && k < remainders.size(); ++k, ++given) {
+            ++parallel[remainders[k].second]->stats.threads;
+        }
+        return *this;
+    }
+
+    // Set once a stage has thrown; workers check it between items
+    bool hasFailed() const { return failed.load(std::memory_order_acquire); }
+
+    PipelineReport run() {
+        if (stages.size() < 2 || stages.back()->hasOutput()) {
+            throw std::runtime_error("Pipeline needs a source and must end in a sink");
+        }
+
+        failed.store(false);
+        error = nullptr;
+        for (auto& stage : stages) stage->prepare(capacity);
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (auto& stage : stages) {
+            stage->active.store(stage->stats.threads);
+            for (size_t i = 0; i < stage->stats.threads; ++i) {
+                threads.emplace_back([&stage]() { stage->worker(); });
+            }
+        }
+        for (auto& t : threads) t.join();
+
+        PipelineReport report;
+        report.wall = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        for (auto& stage : stages) report.stages.push_back(stage->stats);
+
+        if (error) std::rethrow_exception(error);
+        return report;
+    }
+};
+
+inline void PipelineStage::worker() {
+    try {
+        work();
+    } catch (...) {
+        pipeline.fail(std::current_exception());
+    }
+    // The last worker out tells the next stage nothing more is coming
+    if (active.fetch_sub(1, std::memory_order_acq_rel) == 1) closeOutput();
+}
+
+template<typename Out, typename Fn>
+class SourceStage : public PipelineStage {
+    Fn fn;
+
+    void prepare(size_t) override { resetStats(); }
+
+    void work() override {
+        Counters local;
+        for (uint64_t sequence = 0; !pipeline.hasFailed(); ++sequence) {
+            auto start = Clock::now();
+            std::optional<Out> item = fn();
+            auto made = Clock::now();
+            local.busy += made - start;
+            if (!item) break;
+            ++local.items;
+
+            bool sent = pipeline.waitForRoom(sequence) && (*output)->push(sequence, std::move(item));
+            local.output_wait += Clock::now() - made;
+            if (!sent) break;
+        }
+        record(local);
+    }
+
+    void closeInput() override {}
+    void closeOutput() override { (*output)->close(); }
+    bool waitForRoom(uint64_t) const override { return true; }
+    bool hasOutput() const override { return true; }
+
+public:
+    PipelineOutput<Out> output = nullptr;
+
+    SourceStage(Pipeline& pipeline, std::string name, Fn fn)
+        : PipelineStage(pipeline, std::move(name), StageMode::SerialInOrder, 1), fn(std::move(fn)) {}
+};
+
+template<typename In, typename Out, typename Fn>
+class TransformStage : public PipelineStage {
+    Fn fn;
+
+    void prepare(size_t capacity) override {
+        resetStats();
+        input = std::make_unique<PipelineChannel<In>>(stats.mode == StageMode::SerialInOrder, capacity);
+    }
+
+    void work() override {
+        Counters local;
+        typename PipelineChannel<In>::Item item;
+        while (!pipeline.hasFailed()) {
+            auto start = Clock::now();
+            if (!input->pop(item)) break;
+            auto taken = Clock::now();
+            local.input_wait += taken - start;
+
+            std::optional<Out> result;
+            auto done = taken;
+            if (item.value) {
+                ++local.items;
+                result = fn(std::move(*item.value));
+                done = Clock::now();
+                local.busy += done - taken;
+                if (!result) ++local.dropped;
+            }
+
+            bool sent = (*output)->push(item.sequence, std::move(result));
+            local.output_wait += Clock::now() - done;
+            if (!sent) break;
+        }
+        record(local);
+    }
+
+    void closeInput() override { input->close(); }
+    void closeOutput() override { if (output) (*output)->close(); }
+    bool waitForRoom(uint64_t sequence) const override { return input->waitForRoom(sequence); }
+    bool hasOutput() const override { return true; }
+
+public:
+    std::unique_ptr<PipelineChannel<In>> input;
+    PipelineOutput<Out> output = nullptr;
+
+    TransformStage(Pipeline& pipeline, std::string name, StageMode mode, size_t threads, Fn fn)
+        : PipelineStage(pipeline, std::move(name), mode, threads), fn(std::move(fn)) {}
+};
+
+template<typename In, typename Fn>
+class SinkStage : public PipelineStage {
+    Fn fn;
+
+    void prepare(size_t capacity) override {
+        resetStats();
+        input = std::make_unique<PipelineChannel<In>>(stats.mode == StageMode::SerialInOrder, capacity);
+    }
+
+    void work() override {
+        Counters local;
+        typename PipelineChannel<In>::Item item;
+        while (!pipeline.hasFailed()) {
+            auto start = Clock::now();
+            if (!input->pop(item)) break;
+            auto taken = Clock::now();
+            local.input_wait += taken - start;
+
+            if (item.value) {
+                ++local.items;
+                fn(std::move(*item.value));
+                local.busy += Clock::now() - taken;
+            }
+        }
+        record(local);
+    }
+
+    void closeInput() override { input->close(); }
+    void closeOutput() override {}
+    bool waitForRoom(uint64_t sequence) const override { return input->waitForRoom(sequence); }
+    bool hasOutput() const override { return false; }
+
+public:
+    std::unique_ptr<PipelineChannel<In>> input;
+
+    SinkStage(Pipeline& pipeline, std::string name, StageMode mode, size_t threads, Fn fn)
+        : PipelineStage(pipeline, std::move(name), mode, threads), fn(std::move(fn)) {}
+};
+
+template<typename T>
+template<typename Out, typename Fn>
+PipelineFlow<Out> PipelineFlow<T>::stage(std::string name, StageMode mode, size_t threads, Fn fn) {
+    auto& next = pipeline.add(
+        std::make_unique<TransformStage<T, Out, Fn>>(pipeline, std::move(name), mode, threads, std::move(fn)));
+    *output = &next.input;
+    return PipelineFlow<Out>(pipeline, &next.output);
+}
+
+template<typename T>
+template<typename Fn>
+Pipeline& PipelineFlow<T>::sink(std::string name, StageMode mode, size_t threads, Fn fn) {
+    auto& next = pipeline.add(
+        std::make_unique<SinkStage<T, Fn>>(pipeline, std::move(name), mode, threads, std::move(fn)));
+    *output = &next.input;
+    return pipeline;
+}
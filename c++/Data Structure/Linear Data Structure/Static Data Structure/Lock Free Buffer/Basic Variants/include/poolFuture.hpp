@@ -0,0 +1,304 @@
+#pragma once
+
+#include "blockPool.hpp"
+#include "inlineTask.hpp"
+#include "waitStrategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// =============================================
+// Pooled Future / Promise Shared State
+// =============================================
+// What ThreadPool::enqueue returns in place of std::future. A
+// std::packaged_task + std::future pair costs a shared_ptr control
+// block, the shared state and a std::function around it. Here the
+// shared state is one object from a BlockPool, recycled after use.
+// It is intrusively counted, with one reference for the task that
+// fills it and one for the future that reads it; whichever side
+// finishes last returns it to the pool.
+//
+// PoolFuture has the std::future calls the pool's users need (get,
+// wait, wait_for, valid) plus ready(). get() spins briefly, then
+// parks on a futex (waitStrategy.hpp); the task only pays for a
+// wake-up when someone is actually waiting.
+//
+// then(fn) composes instead of waiting: it consumes the future and
+// returns one for fn's result. fn is called with the ready future if
+// it accepts one (so it can see an exception), or else with the value,
+// and an exception then skips fn and passes to the new future. A
+// generic lambda is thus handed the future. fn does not run on the
+// thread that completes the task. That thread only hands fn, as a
+// task, to the future's FutureExecutor: for futures from a ThreadPool,
+// the same pool. No thread waits for the result in the meantime, so a
+// worker never parks on another task. when_all / when_any
+// (futureCombinators.hpp) build on the same hook.
+//
+// Continuations hang off the shared state in a lock-free list. The
+// completing thread swaps in a "fired" marker and schedules everything
+// it finds; a continuation added after that sees the marker and is
+// scheduled straight away.
+
+// Where continuations go once a result is in. ThreadPool hands out
+// itself; an empty executor runs them on the completing thread, which
+// is only right for short, non-blocking bookkeeping.
+struct FutureExecutor {
+    void* context = nullptr;
+    void (*submit)(void* context, InlineTask&& task) = nullptr;
+};
+
+struct FutureContinuation {
+    InlineTask task;
+    FutureExecutor executor;
+    FutureContinuation* next = nullptr;
+
+    FutureContinuation() = default;
+
+    template<typename Fn>
+    FutureContinuation(Fn&& fn, FutureExecutor executor) : task(std::forward<Fn>(fn)), executor(executor) {}
+
+    // The list head once the continuations have been run
+    static FutureContinuation* fired() {
+        static FutureContinuation marker;
+        return &marker;
+    }
+
+    // Hands the task over, or runs it, and frees this node
+    void schedule() {
+        if (executor.submit) {
+            executor.submit(executor.context, std::move(task));
+        } else {
+            task();
+        }
+        poolDelete(this);
+    }
+};
+
+template<typename T>
+class FutureState {
+    using Stored = std::conditional_t<std::is_void_v<T>, std::monostate,
+                   std::conditional_t<std::is_reference_v<T>,
+                                      std::reference_wrapper<std::remove_reference_t<T>>, T>>;
+
+    enum : uint32_t { Pending, HasValue, HasError };
+
+    std::atomic<uint32_t> refs{2}; // the task and the future
+    std::atomic<uint32_t> status{Pending};
+    std::atomic<uint32_t> epoch{0};
+    std::atomic<uint32_t> waiting{0};
+    std::atomic<FutureContinuation*> continuations{nullptr};
+    std::exception_ptr error;
+    std::optional<Stored> value;
+
+    void publish(uint32_t outcome) {
+        status.store(outcome, std::memory_order_release);
+        notifyWaiter(epoch, waiting);
+
+        // Run them in the order they were added
+        FutureContinuation* list = continuations.exchange(FutureContinuation::fired(), std::memory_order_acq_rel);
+        FutureContinuation* ordered = nullptr;
+        while (list) {
+            FutureContinuation* next = list->next;
+            list->next = ordered;
+            ordered = list;
+            list = next;
+        }
+        while (ordered) {
+            FutureContinuation* next = ordered->next;
+            ordered->schedule();
+            ordered = next;
+        }
+    }
+
+public:
+    // Runs `fn`, stores what it returns or throws, and drops the task's reference
+    template<typename Fn>
+    void complete(Fn&& fn) {
+        uint32_t outcome = HasValue;
+        try {
+            if constexpr (std::is_void_v<T>) {
+                std::forward<Fn>(fn)();
+                value.emplace();
+            } else {
+                value.emplace(std::forward<Fn>(fn)());
+            }
+        } catch (...) {
+            error = std::current_exception();
+            outcome = HasError;
+        }
+        publish(outcome);
+        release();
+    }
+
+    bool ready() const { return status.load(std::memory_order_acquire) != Pending; }
+
+    // Schedules `continuation` once the result is in: from complete(),
+    // or right here if that has already happened
+    void onReady(FutureContinuation* continuation) {
+        FutureContinuation* head = continuations.load(std::memory_order_acquire);
+        do {
+            if (head == FutureContinuation::fired()) {
+                continuation->schedule();
+                return;
+            }
+            continuation->next = head;
+        } while (!continuations.compare_exchange_weak(head, continuation, std::memory_order_acq_rel,
+                                                      std::memory_order_acquire));
+    }
+
+    // False if `deadline` passed first
+    bool waitUntil(WaitClock::time_point deadline) {
+        return ::waitUntil([this]() { return ready(); }, epoch, waiting, deadline, WaitStrategy{});
+    }
+
+    // Only once ready
+    T take() {
+        if (status.load(std::memory_order_acquire) == HasError) std::rethrow_exception(error);
+        if constexpr (std::is_void_v<T>) {
+            return;
+        } else if constexpr (std::is_reference_v<T>) {
+            return value->get();
+        } else {
+            return std::move(*value);
+        }
+    }
+
+    void release() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) poolDelete(this);
+    }
+};
+
+template<typename T>
+class PoolFuture;
+
+// What then(fn) returns a future of
+template<typename T, typename F>
+auto continuationResult() {
+    if constexpr (std::is_invocable_v<F, PoolFuture<T>>) {
+        return std::type_identity<std::invoke_result_t<F, PoolFuture<T>>>{};
+    } else if constexpr (std::is_void_v<T>) {
+        return std::type_identity<std::invoke_result_t<F>>{};
+    } else {
+        return std::type_identity<std::invoke_result_t<F, T>>{};
+    }
+}
+
+template<typename T, typename F>
+using ContinuationResult = typename decltype(continuationResult<T, F>())::type;
+
+template<typename T>
+class PoolFuture {
+    FutureState<T>* state = nullptr;
+    FutureExecutor executor;
+
+    friend struct FutureAccess;
+
+    void check() const {
+        if (!state) throw std::future_error(std::future_errc::no_state);
+    }
+
+public:
+    PoolFuture() = default;
+    explicit PoolFuture(FutureState<T>* state, FutureExecutor executor = {}) : state(state), executor(executor) {}
+
+    PoolFuture(PoolFuture&& other) noexcept
+        : state(std::exchange(other.state, nullptr)), executor(other.executor) {}
+
+    PoolFuture& operator=(PoolFuture&& other) noexcept {
+        if (this != &other) {
+            if (state) state->release();
+            state = std::exchange(other.state, nullptr);
+            executor = other.executor;
+        }
+        return *this;
+    }
+
+    PoolFuture(const PoolFuture&) = delete;
+    PoolFuture& operator=(const PoolFuture&) = delete;
+
+    // Never blocks: an unfinished task just drops its result later
+    ~PoolFuture() {
+        if (state) state->release();
+    }
+
+    bool valid() const { return state != nullptr; }
+
+    bool ready() const {
+        check();
+        return state->ready();
+    }
+
+    void wait() const {
+        check();
+        state->waitUntil(WaitClock::time_point::max());
+    }
+
+    template<typename Rep, typename Period>
+    std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout) const {
+        check();
+        return state->waitUntil(deadlineAfter(timeout)) ? std::future_status::ready : std::future_status::timeout;
+    }
+
+    // Waits, then returns the value or rethrows; the future is empty afterwards
+    T get() {
+        check();
+        state->waitUntil(WaitClock::time_point::max());
+        struct Release {
+            FutureState<T>* state;
+            ~Release() { state->release(); }
+        } release{std::exchange(state, nullptr)};
+        return release.state->take();
+    }
+
+    // Schedules fn(this future, ready) or fn(its value) to run once the
+    // result is in, and returns the future of what fn returns. Never
+    // blocks; the future is empty afterwards.
+    template<typename F>
+    auto then(F&& fn) -> PoolFuture<ContinuationResult<T, std::decay_t<F>>> {
+        using Fn = std::decay_t<F>;
+        using R = ContinuationResult<T, Fn>;
+        check();
+
+        auto* next = poolNew<FutureState<R>>();
+        FutureState<T>* source = std::exchange(state, nullptr);
+        FutureExecutor target = executor;
+        source->onReady(poolNew<FutureContinuation>(
+            [source, next, target, fn = std::forward<F>(fn)]() mutable {
+                PoolFuture ready(source, target); // takes over this future's reference
+                next->complete([&]() -> R {
+                    if constexpr (std::is_invocable_v<Fn, PoolFuture<T>>) {
+                        return std::invoke(std::move(fn), std::move(ready));
+                    } else if constexpr (std::is_void_v<T>) {
+                        ready.get();
+                        return std::invoke(std::move(fn));
+                    } else {
+                        return std::invoke(std::move(fn), ready.get());
+                    }
+                });
+            },
+            target));
+        return PoolFuture<R>(next, target);
+    }
+};
+
+// Lets when_all / when_any reach the shared state behind a future
+struct FutureAccess {
+    template<typename T>
+    static FutureState<T>* state(PoolFuture<T>& future) {
+        future.check();
+        return future.state;
+    }
+
+    template<typename T>
+    static FutureExecutor executor(const PoolFuture<T>& future) {
+        return future.executor;
+    }
+};
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "cacheLine.hpp"
+#include "waitStrategy.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// =============================================
+// Reorder Buffer: Parallel In, Sequential Out
+// =============================================
+// Many producers insert items tagged with a sequence number, in any
+// order; one consumer takes them out strictly as 0, 1, 2, ...
+//
+// Item `s` lives in slot `s % window`. A producer whose item is a full
+// window ahead of the consumer waits, which bounds memory and keeps
+// one slow chunk from letting the others run away. The producer
+// holding the oldest missing sequence never waits, so the pipeline
+// cannot deadlock.
+//
+// Producers wait with C++20 atomic wait on pop_epoch. The consumer
+// waits per its WaitStrategy on the insert_epoch futex (see
+// waitUntil), which also gives it a timeout. close() bumps both
+// counters so nobody sleeps through it.
+template<typename T>
+class ReorderBuffer {
+    struct Slot {
+        std::atomic<bool> ready{false};
+        T value{};
+    };
+
+    std::vector<Slot> slots;
+
+    alignas(cacheLineSize) std::atomic<uint64_t> next_out{0};      // consumer position
+    std::atomic<uint32_t> pop_epoch{0};                            // bumped on pop/close
+    alignas(cacheLineSize) std::atomic<uint32_t> insert_epoch{0};  // bumped on insert/close
+    std::atomic<uint32_t> consumer_waiting{0};
+    std::atomic<bool> closed{false};
+
+    WaitStrategy strategy;
+
+    bool take(T& value) {
+        uint64_t sequence = next_out.load(std::memory_order_relaxed);
+        Slot& slot = slots[sequence % slots.size()];
+        if (!slot.ready.load(std::memory_order_acquire)) return false;
+
+        value = std::move(slot.value);
+        slot.ready.store(false, std::memory_order_relaxed);
+
+        next_out.store(sequence + 1, std::memory_order_release);
+        pop_epoch.fetch_add(1, std::memory_order_release);
+        pop_epoch.notify_all();
+        return true;
+    }
+
+public:
+    explicit ReorderBuffer(size_t window, WaitStrategy consumer_wait = {})
+        : slots(window), strategy(consumer_wait) {}
+
+    ReorderBuffer(const ReorderBuffer&) = delete;
+    ReorderBuffer& operator=(const ReorderBuffer&) = delete;
+
+    // Any thread. Blocks while `sequence` is a window ahead of the
+    // consumer. Returns false if the buffer was closed meanwhile.
+    bool waitForRoom(uint64_t sequence) const {
+        while (true) {
+            uint32_t epoch = pop_epoch.load(std::memory_order_acquire);
+            if (sequence < next_out.load(std::memory_order_acquire) + slots.size()) return true;
+            if (closed.load(std::memory_order_acquire)) return false;
+            pop_epoch.wait(epoch, std::memory_order_acquire);
+        }
+    }
+
+    // Any thread. Waits for room as above, then stores the item.
+    bool insert(uint64_t sequence, T value) {
+        if (!waitForRoom(sequence)) return false;
+
+        Slot& slot = slots[sequence % slots.size()];
+        slot.value = std::move(value);
+        slot.ready.store(true, std::memory_order_release);
+
+        notifyWaiter(insert_epoch, consumer_waiting);
+        return true;
+    }
+
+    // Single consumer, non-blocking: the next item in sequence, if there
+    bool try_pop(T& value) {
+        return take(value);
+    }
+
+    // Single consumer. Waits for the next item in sequence. Returns false
+    // on timeout or once closed without it; finished() tells them apart.
+    bool pop_wait(T& value, std::chrono::nanoseconds timeout) {
+        bool got = false;
+        waitUntil([&]() { return (got = take(value)) || closed.load(std::memory_order_acquire); },
+                  insert_epoch, consumer_waiting, deadlineAfter(timeout), strategy);
+        // An item inserted before close() may have landed after the check
+        return got || take(value);
+    }
+
+    // Single consumer. Blocks until the next item in sequence is there.
+    // Returns false once closed and that item will never arrive.
+    bool pop(T& value) {
+        return pop_wait(value, std::chrono::nanoseconds::max());
+    }
+
+    // Closed and the next item in sequence will never arrive
+    bool finished() const {
+        uint64_t sequence = next_out.load(std::memory_order_relaxed);
+        return closed.load(std::memory_order_acquire) &&
+               !slots[sequence % slots.size()].ready.load(std::memory_order_acquire);
+    }
+
+    // Call once every producer is done (or to abort); wakes everyone
+    void close() {
+        closed.store(true, std::memory_order_release);
+        insert_epoch.fetch_add(1, std::memory_order_release);
+        futexWake(insert_epoch);
+        pop_epoch.fetch_add(1, std::memory_order_release);
+        pop_epoch.notify_all();
+    }
+
+    // Next sequence the consumer will hand out
+    uint64_t position() const {
+        return next_out.load(std::memory_order_acquire);
+    }
+};
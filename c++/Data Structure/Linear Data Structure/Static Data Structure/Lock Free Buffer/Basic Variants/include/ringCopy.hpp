@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+// =============================================
+// Wrap-Around Copy Helpers for Ring Storage
+// =============================================
+// A run of `count` slots starting at `index` is at most two contiguous
+// pieces: [index, size) and [0, rest). These helpers do the split so
+// the batched push_n/pop_n of every ring buffer share one copy path.
+
+// Copy (or move, with a move_iterator) `count` elements from `src`
+// into `ring` starting at slot `index`.
+template<typename InputIt, typename Ring>
+void copyIntoRing(InputIt src, size_t count, Ring& ring, size_t index, size_t size) {
+    size_t first = std::min(count, size - index);
+    std::copy_n(src, first, std::begin(ring) + index);
+    std::advance(src, first);
+    std::copy_n(src, count - first, std::begin(ring));
+}
+
+// Move `count` elements out of `ring` starting at slot `index` into `dst`.
+template<typename Ring, typename OutputIt>
+void moveOutOfRing(Ring& ring, size_t index, size_t count, size_t size, OutputIt dst) {
+    size_t first = std::min(count, size - index);
+    auto begin = std::begin(ring);
+    dst = std::move(begin + index, begin + index + first, dst);
+    std::move(begin, begin + (count - first), dst);
+}
+
+// Raw-storage forms (see ringStorage.hpp): construct `count` elements
+// from `src` into the uninitialized slots starting at `index`. If a
+// constructor throws, whatever was built is destroyed again.
+template<typename InputIt, typename T>
+void constructIntoRing(InputIt src, size_t count, T* ring, size_t index, size_t size) {
+    size_t first = std::min(count, size - index);
+    std::uninitialized_copy_n(src, first, ring + index);
+    std::advance(src, first);
+    try {
+        std::uninitialized_copy_n(src, count - first, ring);
+    } catch (...) {
+        std::destroy_n(ring + index, first);
+        throw;
+    }
+}
+
+// Move `count` live elements starting at slot `index` into `dst` and
+// destroy them in place, leaving the slots uninitialized.
+template<typename T, typename OutputIt>
+void relocateOutOfRing(T* ring, size_t index, size_t count, size_t size, OutputIt dst) {
+    size_t first = std::min(count, size - index);
+    dst = std::move(ring + index, ring + index + first, dst);
+    std::move(ring, ring + (count - first), dst);
+    std::destroy_n(ring + index, first);
+    std::destroy_n(ring, count - first);
+}
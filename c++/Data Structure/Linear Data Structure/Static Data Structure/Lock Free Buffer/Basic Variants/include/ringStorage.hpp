@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// =============================================
+// Raw Slot Storage for Ring Buffers
+// =============================================
+// `size` uninitialized slots, aligned for T, in one block. Nothing is
+// constructed up front: an element exists only from construct() to
+// destroy(), so T needs no default constructor and only live elements
+// cost anything. The owning buffer knows which slots are live (tail up
+// to head) and must destroy them itself.
+template<typename T>
+class RingStorage {
+    T* slots;
+
+public:
+    explicit RingStorage(size_t size)
+        : slots(static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t{alignof(T)}))) {}
+
+    ~RingStorage() {
+        ::operator delete(slots, std::align_val_t{alignof(T)});
+    }
+
+    RingStorage(const RingStorage&) = delete;
+    RingStorage& operator=(const RingStorage&) = delete;
+
+    T* data() { return slots; }
+
+    // Only valid for a live slot
+    T& operator[](size_t index) { return *std::launder(slots + index); }
+    const T& operator[](size_t index) const { return *std::launder(slots + index); }
+
+    template<typename... Args>
+    T* construct(size_t index, Args&&... args) {
+        return ::new (static_cast<void*>(slots + index)) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(size_t index) {
+        std::destroy_at(std::launder(slots + index));
+    }
+};
@@ -0,0 +1,254 @@
+#pragma once
+
+#include "cacheLine.hpp"
+#include "waitStrategy.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// =============================================
+// Inter-Process SPSC Ring Buffer in POSIX Shared Memory
+// =============================================
+// The LockFreeRingBuffer layout (power-of-two slots, wrapped head/tail,
+// Size - 1 usable) placed in a named shm_open segment, so a producer
+// process and a consumer process can pass items without sockets.
+//
+// Segment:  [ Header | Size slots of T ]
+//
+// Attach/detach:
+//  * Whichever side comes first creates and initialises the segment;
+//    the other waits for `magic` to appear, then checks that T and
+//    Size match.
+//  * Each role (producer/consumer) is owned by one pid. A role held by
+//    a pid that no longer exists is taken over, so a crashed process
+//    can simply be restarted. (A recycled pid looks alive; detach
+//    cleanly where possible.)
+//  * A crash never exposes a half-written item: head only moves after
+//    the slot is written, and tail only after it has been read.
+//
+// Wake-ups use process-shared futexes on words inside the segment.
+// The segment outlives both processes until unlink() is called.
+enum class ShmRole { Producer, Consumer };
+
+template<typename T, size_t Size>
+class SharedMemoryRingBuffer {
+    static_assert((Size & (Size - 1)) == 0, "Size must be a power of 2");
+    static_assert(std::is_trivially_copyable_v<T>, "Shared-memory payloads must be trivially copyable");
+    static_assert(std::atomic<uint64_t>::is_always_lock_free, "Atomics in shared memory must be lock-free");
+
+    static constexpr uint64_t header_magic = 0x52494e4753484d31; // "RINGSHM1"
+
+    struct Header {
+        std::atomic<uint64_t> magic;      // written last by the creator
+        uint64_t element_size;
+        uint64_t capacity;
+
+        // Written by the producer
+        alignas(cacheLineSize) std::atomic<uint64_t> head;
+        std::atomic<uint32_t> pushEpoch;
+        std::atomic<uint32_t> producerWaiting;
+        std::atomic<int32_t> producerPid;
+
+        // Written by the consumer
+        alignas(cacheLineSize) std::atomic<uint64_t> tail;
+        std::atomic<uint32_t> popEpoch;
+        std::atomic<uint32_t> consumerWaiting;
+        std::atomic<int32_t> consumerPid;
+    };
+
+    struct alignas(cacheLineSize) Layout {
+        Header header;
+        alignas(cacheLineSize) T slots[Size];
+    };
+
+    std::string name;
+    ShmRole role;
+    WaitStrategy strategy;
+    Layout* shm = nullptr;
+
+    Header& header() { return shm->header; }
+
+    static bool processAlive(int32_t pid) {
+        return pid > 0 && (kill(pid, 0) == 0 || errno != ESRCH);
+    }
+
+    void claimRole() {
+        std::atomic<int32_t>& owner = role == ShmRole::Producer ? header().producerPid : header().consumerPid;
+        int32_t self = static_cast<int32_t>(getpid());
+        int32_t current = owner.load(std::memory_order_acquire);
+        while (true) {
+            if (current != 0 && processAlive(current)) {
+                throw std::runtime_error("Shared ring '" + name + "' already has a live " +
+                                         (role == ShmRole::Producer ? "producer" : "consumer"));
+            }
+            // Free, or left behind by a crashed process, which may have
+            // died parked and still be counted as waiting
+            if (owner.compare_exchange_weak(current, self, std::memory_order_acq_rel)) {
+                (role == ShmRole::Producer ? header().producerWaiting : header().consumerWaiting)
+                    .store(0, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    void releaseRole() {
+        std::atomic<int32_t>& owner = role == ShmRole::Producer ? header().producerPid : header().consumerPid;
+        int32_t self = static_cast<int32_t>(getpid());
+        owner.compare_exchange_strong(self, 0, std::memory_order_acq_rel);
+    }
+
+public:
+    SharedMemoryRingBuffer(const std::string& name, ShmRole role, WaitStrategy strategy = {},
+                           std::chrono::milliseconds attach_timeout = std::chrono::seconds(5))
+        : name(name), role(role), strategy(strategy) {
+        bool creator = true;
+        int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0 && errno == EEXIST) {
+            creator = false;
+            fd = shm_open(name.c_str(), O_RDWR, 0600);
+        }
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open shared memory '" + name + "'");
+        }
+
+        if (creator && ftruncate(fd, sizeof(Layout)) != 0) {
+            close(fd);
+            shm_unlink(name.c_str());
+            throw std::runtime_error("Failed to size shared memory '" + name + "'");
+        }
+
+        // An attacher may get here before the creator's ftruncate
+        auto deadline = deadlineAfter(attach_timeout);
+        struct stat st {};
+        while (!creator && (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Layout))) {
+            if (st.st_size > 0 && static_cast<size_t>(st.st_size) != sizeof(Layout)) {
+                close(fd);
+                throw std::runtime_error("Shared ring '" + name + "' has a different layout");
+            }
+            if (WaitClock::now() >= deadline) {
+                close(fd);
+                throw std::runtime_error("Timed out attaching to shared ring '" + name + "'");
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        void* area = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (area == MAP_FAILED) {
+            throw std::runtime_error("Failed to map shared memory '" + name + "'");
+        }
+        shm = static_cast<Layout*>(area);
+
+        if (creator) {
+            // ftruncate zero-fills, which is a valid empty ring; fill in the rest
+            header().element_size = sizeof(T);
+            header().capacity = Size;
+            header().magic.store(header_magic, std::memory_order_release);
+        } else {
+            while (header().magic.load(std::memory_order_acquire) != header_magic) {
+                if (WaitClock::now() >= deadline) {
+                    munmap(shm, sizeof(Layout));
+                    throw std::runtime_error("Timed out waiting for shared ring '" + name + "' to initialise");
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            if (header().element_size != sizeof(T) || header().capacity != Size) {
+                munmap(shm, sizeof(Layout));
+                throw std::runtime_error("Shared ring '" + name + "' has a different element type or size");
+            }
+        }
+
+        try {
+            claimRole();
+        } catch (...) {
+            munmap(shm, sizeof(Layout));
+            throw;
+        }
+    }
+
+    ~SharedMemoryRingBuffer() {
+        releaseRole();
+        munmap(shm, sizeof(Layout));
+    }
+
+    SharedMemoryRingBuffer(const SharedMemoryRingBuffer&) = delete;
+    SharedMemoryRingBuffer& operator=(const SharedMemoryRingBuffer&) = delete;
+
+    // Removes the name; mapped segments stay valid until detached
+    static void unlink(const std::string& name) {
+        shm_unlink(name.c_str());
+    }
+
+    // Producer only
+    bool push(const T& item) {
+        Header& h = header();
+        uint64_t current = h.head.load(std::memory_order_relaxed);
+        uint64_t next = (current + 1) & (Size - 1);
+
+        if (next == h.tail.load(std::memory_order_acquire)) {
+            return false; // buffer full
+        }
+
+        shm->slots[current] = item;
+        h.head.store(next, std::memory_order_release);
+        notifyWaiter(h.pushEpoch, h.consumerWaiting, true);
+        return true;
+    }
+
+    // Consumer only
+    bool pop(T& item) {
+        Header& h = header();
+        uint64_t current = h.tail.load(std::memory_order_relaxed);
+
+        if (current == h.head.load(std::memory_order_acquire)) {
+            return false; // buffer empty
+        }
+
+        item = shm->slots[current];
+        h.tail.store((current + 1) & (Size - 1), std::memory_order_release);
+        notifyWaiter(h.popEpoch, h.producerWaiting, true);
+        return true;
+    }
+
+    bool push_wait(const T& item,
+                   std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) {
+        return waitUntil([&]() { return push(item); }, header().popEpoch, header().producerWaiting,
+                         deadlineAfter(timeout), strategy, true);
+    }
+
+    bool pop_wait(T& item,
+                  std::chrono::nanoseconds timeout = std::chrono::nanoseconds::max()) {
+        return waitUntil([&]() { return pop(item); }, header().pushEpoch, header().consumerWaiting,
+                         deadlineAfter(timeout), strategy, true);
+    }
+
+    bool isEmpty() {
+        return header().head.load(std::memory_order_acquire) == header().tail.load(std::memory_order_acquire);
+    }
+
+    // Whether the other side is currently attached
+    bool peerAttached() {
+        auto& pid = role == ShmRole::Producer ? header().consumerPid : header().producerPid;
+        return processAlive(pid.load(std::memory_order_acquire));
+    }
+
+    // The pid holding the other role, 0 if none; it may have died
+    // without detaching (see peerAttached())
+    int32_t peerPid() {
+        auto& pid = role == ShmRole::Producer ? header().consumerPid : header().producerPid;
+        return pid.load(std::memory_order_acquire);
+    }
+};
@@ -0,0 +1,176 @@
+#pragma once
+
+#include "cacheLine.hpp"
+#include "ringCopy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <span>
+#include <vector>
+
+// =============================================
+// False-Sharing-Free SPSC Ring Buffer
+// =============================================
+// Same contract as LockFreeRingBuffer (one producer, one consumer,
+// Size - 1 usable slots), but:
+//  * head and tail live on separate cache lines, so the producer
+//    writing head does not invalidate the line the consumer writes.
+//  * each side keeps a private copy of the other side's index and
+//    only re-reads the shared atomic when that copy says the ring is
+//    full (producer) or empty (consumer).
+// In steady state push/pop touch only their own cache line.
+template<typename T, size_t Size>
+class SpscRingBuffer {
+    static_assert((Size & (Size - 1)) == 0, "Size must be a power of 2");
+
+    // Producer-owned line
+    alignas(cacheLineSize) std::atomic<size_t> head{0};
+    size_t cachedTail = 0;   // producer's last view of tail
+
+    // Consumer-owned line
+    alignas(cacheLineSize) std::atomic<size_t> tail{0};
+    size_t cachedHead = 0;   // consumer's last view of head
+
+    // Read-only after construction, kept off both index lines
+    alignas(cacheLineSize) std::vector<T> buffer;
+
+    template<typename InputIt>
+    size_t pushRun(InputIt items, size_t count) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t free_slots = (cachedTail - h - 1) & (Size - 1);
+
+        if (free_slots < count) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            free_slots = (cachedTail - h - 1) & (Size - 1);
+        }
+
+        size_t n = std::min(count, free_slots);
+        if (n == 0) return 0;
+
+        copyIntoRing(items, n, buffer, h, Size);
+        head.store((h + n) & (Size - 1), std::memory_order_release);
+        return n;
+    }
+
+public:
+    SpscRingBuffer() : buffer(Size) {}
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    // Producer only
+    bool push(const T& item) {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t next = (h + 1) & (Size - 1);
+
+        if (next == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (next == cachedTail) {
+                return false; // buffer full
+            }
+        }
+
+        buffer[h] = item;
+        head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    bool pop(T& item) {
+        size_t t = tail.load(std::memory_order_relaxed);
+
+        if (t == cachedHead) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t == cachedHead) {
+                return false; // buffer empty
+            }
+        }
+
+        item = buffer[t];
+        tail.store((t + 1) & (Size - 1), std::memory_order_release);
+        return true;
+    }
+
+    // Batched forms: transfer as many elements as fit / are available,
+    // publish head or tail once, and return how many were moved.
+    // Producer only
+    size_t push_n(std::span<const T> items) {
+        return pushRun(items.begin(), items.size());
+    }
+
+    // Producer only
+    size_t push_n_move(std::span<T> items) {
+        return pushRun(std::make_move_iterator(items.begin()), items.size());
+    }
+
+    // Consumer only
+    size_t pop_n(std::span<T> out) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t available = (cachedHead - t) & (Size - 1);
+
+        if (available < out.size()) {
+            cachedHead = head.load(std::memory_order_acquire);
+            available = (cachedHead - t) & (Size - 1);
+        }
+
+        size_t n = std::min(out.size(), available);
+        if (n == 0) return 0;
+
+        moveOutOfRing(buffer, t, n, Size, out.begin());
+        tail.store((t + n) & (Size - 1), std::memory_order_release);
+        return n;
+    }
+
+    // Zero-copy slot access: claim/commit on the producer, peek/release
+    // on the consumer. Unlike LockFreeRingBuffer's raw slots (claimRaw),
+    // these hold live objects that are reused: claim returns the
+    // previous lap's T to overwrite, so e.g. a std::string keeps its
+    // capacity.
+    // Producer only
+    T* claim() {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t next = (h + 1) & (Size - 1);
+
+        if (next == cachedTail) {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (next == cachedTail) {
+                return nullptr; // buffer full
+            }
+        }
+        return &buffer[h];
+    }
+
+    // Producer only, after a successful claim()
+    void commit() {
+        size_t h = head.load(std::memory_order_relaxed);
+        head.store((h + 1) & (Size - 1), std::memory_order_release);
+    }
+
+    // Consumer only
+    T* peek() {
+        size_t t = tail.load(std::memory_order_relaxed);
+
+        if (t == cachedHead) {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t == cachedHead) {
+                return nullptr; // buffer empty
+            }
+        }
+        return &buffer[t];
+    }
+
+    // Consumer only, after a successful peek()
+    void release() {
+        size_t t = tail.load(std::memory_order_relaxed);
+        tail.store((t + 1) & (Size - 1), std::memory_order_release);
+    }
+
+    // Approximate when called concurrently with push/pop
+    bool isEmpty() const {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    static constexpr size_t capacity() { return Size - 1; }
+};
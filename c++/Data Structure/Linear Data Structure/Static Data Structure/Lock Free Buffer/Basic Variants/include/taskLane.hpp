@@ -0,0 +1,94 @@
+#pragma once
+
+#include "cacheLine.hpp"
+#include "waitStrategy.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// =============================================
+// Priority Lanes with Earliest-Deadline-First Order
+// =============================================
+// ThreadPool keeps one TaskLane per priority. A lane is a binary heap
+// under a mutex, ordered by deadline and then by submission order.
+// Within a lane the most urgent task runs first, and tasks without a
+// deadline run FIFO after every task that has one. A task that starts
+// after its deadline still runs, but counts as a miss.
+//
+// Lanes are for work that is submitted with TaskOptions. Plain
+// enqueue()/post() keep the lock-free work-stealing path. A worker
+// that finds a lane empty reads one atomic and never takes the lock.
+
+enum class TaskPriority { High, Normal, Low };
+
+inline constexpr size_t task_priority_count = 3;
+
+struct TaskOptions {
+    TaskPriority priority = TaskPriority::Normal;
+    std::optional<WaitClock::time_point> deadline;
+};
+
+struct LaneStats {
+    size_t depth = 0;           // queued now
+    size_t high_water = 0;      // most ever queued at once
+    uint64_t submitted = 0;
+    uint64_t deadline_missed = 0; // started after their deadline
+};
+
+template<typename Task>
+class TaskLane {
+    struct Entry {
+        WaitClock::time_point deadline;
+        uint64_t sequence;
+        Task* task;
+    };
+
+    // std heaps keep the largest on top, so "larger" means "runs later"
+    static bool runsLater(const Entry& a, const Entry& b) {
+        return a.deadline != b.deadline ? a.deadline > b.deadline : a.sequence > b.sequence;
+    }
+
+    std::mutex mutex;
+    std::vector<Entry> heap;
+    uint64_t next_sequence = 0;
+    size_t high_water = 0;
+    uint64_t missed = 0;
+
+    alignas(cacheLineSize) std::atomic<size_t> depth{0};
+
+public:
+    void push(Task* task, std::optional<WaitClock::time_point> deadline) {
+        std::lock_guard<std::mutex> lock(mutex);
+        heap.push_back({deadline.value_or(WaitClock::time_point::max()), next_sequence++, task});
+        std::push_heap(heap.begin(), heap.end(), runsLater);
+        high_water = std::max(high_water, heap.size());
+        depth.store(heap.size(), std::memory_order_release);
+    }
+
+    bool tryPop(Task*& task) {
+        if (depth.load(std::memory_order_acquire) == 0) return false;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (heap.empty()) return false;
+        std::pop_heap(heap.begin(), heap.end(), runsLater);
+        Entry entry = heap.back();
+        heap.pop_back();
+        depth.store(heap.size(), std::memory_order_release);
+
+        if (entry.deadline != WaitClock::time_point::max() && WaitClock::now() > entry.deadline) ++missed;
+        task = entry.task;
+        return true;
+    }
+
+    size_t size() const { return depth.load(std::memory_order_relaxed); }
+
+    LaneStats stats() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return {heap.size(), high_water, next_sequence, missed};
+    }
+};
@@ -0,0 +1,354 @@
+#pragma once
+
+#include "blockPool.hpp"
+#include "futex.hpp"
+#include "inlineTask.hpp"
+#include "mpmcQueue.hpp"
+#include "poolFuture.hpp"
+#include "taskLane.hpp"
+#include "waitStrategy.hpp"
+#include "workStealingDeque.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// =============================================
+// Work-Stealing Thread Pool
+// =============================================
+// The ThreadPool from Concurrency/Thread Pool/main.cpp with the same
+// enqueue(), minus its single mutex-guarded std::queue:
+//  * every worker owns a WorkStealingDeque (Chase-Lev). A task
+//    enqueued from inside a task goes to the bottom of its worker's
+//    deque, with no lock and no shared cache line touched;
+//  * an enqueue from outside the pool goes through a lock-free
+//    injection queue (MpmcQueue) that all workers drain. When that is
+//    full, it goes to an overflow list under a mutex, drained after
+//    the queue, so an enqueue never waits for the workers;
+//  * a worker looks for work in its own deque (newest first), then the
+//    injection queue, then steals the oldest task of another worker,
+//    starting from a random victim so thieves spread out;
+//  * every `inject_interval` local tasks it checks the injection queue
+//    first, so outside submissions are not starved by a worker that
+//    keeps feeding itself.
+// Idle workers spin briefly, then sleep on a futex. Submitters only
+// pay for a wake-up syscall when someone is asleep: the sleeper
+// registers, fences, then re-checks for work; the submitter publishes,
+// fences, then checks for sleepers (the notifyWaiter handshake from
+// waitStrategy.hpp, with a count instead of a flag).
+//
+// Submitting allocates nothing once the pool is warm. A task is an
+// InlineTask (the callable stored inline, no std::function or
+// std::bind), and both it and enqueue()'s future state come from a
+// BlockPool (blockPool.hpp) that recycles them. post() is enqueue()
+// without the future, for fire-and-forget work. The futures' then()
+// posts its continuation back to this pool once the result is in, so
+// tasks can be chained without a worker blocking in get().
+//
+// Work can also be submitted with TaskOptions: a priority (High, Normal
+// or Low) and an optional deadline. Each priority has its own TaskLane
+// (taskLane.hpp), which runs the earliest deadline first. Workers
+// look in the High lane before anything else, then at Normal work (the
+// Normal lane, then the deques and injection queue as above), then at
+// the Low lane. So that a flood of urgent work cannot starve the rest,
+// every `normal_interval`-th pick of a worker tries Normal work first,
+// and every `low_interval`-th pick tries the Low lane first. A running
+// task is never preempted: under full load a High task waits for at
+// most one task per worker to finish, plus those two bounded skips.
+// laneStats() reports each lane's depth, high-water mark, submissions
+// and missed deadlines.
+//
+// The destructor lets the workers drain all queued work, as before.
+class ThreadPool {
+private:
+    using Task = InlineTask;
+
+    struct alignas(cacheLineSize) Worker {
+        WorkStealingDeque<Task*> deque;
+        uint64_t rng;      // victim selection, xorshift
+        uint32_t ticks = 0; // local tasks since the injection queue was checked
+        uint32_t picks = 0; // tasks looked for, for the lane rotation
+    };
+
+    static constexpr uint32_t inject_interval = 61;
+    static constexpr uint32_t normal_interval = 8;
+    static constexpr uint32_t low_interval = 32;
+    static constexpr int idle_spins = 64;
+
+    int m_maxThread;
+    std::vector<std::unique_ptr<Worker>> queues;
+    std::vector<std::thread> workers;
+    MpmcQueue<Task*> injected;
+    std::array<TaskLane<Task>, task_priority_count> lanes;
+
+    // Outside submissions that found `injected` full, oldest at
+    // `overflow_head`
+    std::mutex overflow_mutex;
+    std::vector<Task*> overflow;
+    size_t overflow_head = 0;
+    alignas(cacheLineSize) std::atomic<size_t> overflow_depth{0};
+
+    alignas(cacheLineSize) std::atomic<uint32_t> epoch{0};
+    alignas(cacheLineSize) std::atomic<uint32_t> sleepers{0};
+    std::atomic<bool> stop{false};
+
+    // The worker the calling thread is, if it belongs to a pool
+    static inline thread_local ThreadPool* current_pool = nullptr;
+    static inline thread_local size_t current_index = 0;
+
+    bool stealFrom(size_t self, Task*& task) {
+        Worker& me = *queues[self];
+        me.rng ^= me.rng << 13;
+        me.rng ^= me.rng >> 7;
+        me.rng ^= me.rng << 17;
+        size_t n = queues.size();
+        size_t start = me.rng % n;
+        for (size_t k = 0; k < n; ++k) {
+            size_t victim = (start + k) % n;
+            if (victim != self && queues[victim]->deque.steal(task)) return true;
+        }
+        return false;
+    }
+
+    TaskLane<Task>& lane(TaskPriority priority) { return lanes[static_cast<size_t>(priority)]; }
+
+    void pushInjected(Task* task) {
+        // Once anything has overflowed, later tasks queue behind it
+        if (overflow_depth.load(std::memory_order_acquire) == 0 && injected.try_push(task)) return;
+        std::lock_guard<std::mutex> lock(overflow_mutex);
+        overflow.push_back(task);
+        overflow_depth.store(overflow.size() - overflow_head, std::memory_order_release);
+    }
+
+    bool popInjected(Task*& task) {
+        if (injected.try_pop(task)) return true;
+        if (overflow_depth.load(std::memory_order_acquire) == 0) return false;
+
+        std::lock_guard<std::mutex> lock(overflow_mutex);
+        if (overflow_head == overflow.size()) return false;
+        task = overflow[overflow_head++];
+        if (overflow_head == overflow.size()) {
+            overflow.clear();
+            overflow_head = 0;
+        }
+        overflow_depth.store(overflow.size() - overflow_head, std::memory_order_release);
+        return true;
+    }
+
+    bool findNormalTask(size_t self, Task*& task) {
+        Worker& me = *queues[self];
+        if (lane(TaskPriority::Normal).tryPop(task)) return true;
+        if (++me.ticks >= inject_interval) {
+            me.ticks = 0;
+            if (popInjected(task)) return true;
+        }
+        return me.deque.pop(task) || popInjected(task) || stealFrom(self, task);
+    }
+
+    bool findTask(size_t self, Task*& task) {
+        Worker& me = *queues[self];
+        ++me.picks;
+        if (me.picks % low_interval == 0 && lane(TaskPriority::Low).tryPop(task)) return true;
+        if (me.picks % normal_interval == 0 && findNormalTask(self, task)) return true;
+        return lane(TaskPriority::High).tryPop(task) || findNormalTask(self, task) ||
+               lane(TaskPriority::Low).tryPop(task);
+    }
+
+    // Wakes one sleeping worker, if there is one
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) != 0) {
+            epoch.fetch_add(1, std::memory_order_release);
+            futexWake(epoch, 1);
+        }
+    }
+
+    // Spins, then sleeps until there is work; false once stopping and
+    // nothing is left
+    bool waitForTask(size_t self, Task*& task) {
+        for (int spins = 0; spins < idle_spins; ++spins) {
+            if (findTask(self, task)) return true;
+            cpuRelax();
+        }
+        while (true) {
+            uint32_t seen = epoch.load(std::memory_order_acquire);
+            sleepers.fetch_add(1, std::memory_order_seq_cst);
+            bool found = findTask(self, task);
+            if (found || stop.load(std::memory_order_acquire)) {
+                sleepers.fetch_sub(1, std::memory_order_relaxed);
+                return found;
+            }
+            futexWait(epoch, seen, std::chrono::seconds(1));
+            sleepers.fetch_sub(1, std::memory_order_relaxed);
+            if (findTask(self, task)) return true;
+        }
+    }
+
+    void workerLoop(size_t self) {
+        current_pool = this;
+        current_index = self;
+        Task* task = nullptr;
+        while (waitForTask(self, task)) runTask(task);
+        current_pool = nullptr;
+    }
+
+    static void runTask(Task* task) {
+        (*task)();
+        poolDelete(task);
+    }
+
+    void submit(Task* task) {
+        if (current_pool == this) {
+            queues[current_index]->deque.push(task);
+        } else {
+            pushInjected(task);
+        }
+        notify();
+    }
+
+    void submit(Task* task, const TaskOptions& options) {
+        lane(options.priority).push(task, options.deadline);
+        notify();
+    }
+
+    // A task that runs f(args...) and stores the outcome in `state`
+    template <class R, class F, class... Args>
+    static Task* makeFutureTask(FutureState<R>* state, F&& f, Args&&... args) {
+        return poolNew<Task>([state, fn = std::forward<F>(f), ...args = std::forward<Args>(args)]() mutable {
+            state->complete([&]() -> R { return std::invoke(std::move(fn), std::move(args)...); });
+        });
+    }
+
+    // A task that runs f(args...) and drops the result
+    template <class F, class... Args>
+    static Task* makeTask(F&& f, Args&&... args) {
+        static_assert(std::is_void_v<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>,
+                      "post() is for tasks that return nothing; use enqueue() for a result");
+        if constexpr (sizeof...(Args) == 0) {
+            return poolNew<Task>(std::forward<F>(f));
+        } else {
+            return poolNew<Task>([fn = std::forward<F>(f), ...args = std::forward<Args>(args)]() mutable {
+                std::invoke(std::move(fn), std::move(args)...);
+            });
+        }
+    }
+
+public:
+    ThreadPool(int i) : m_maxThread(i), injected(4096) {
+        std::cout << "Constructor is called" << std::endl;
+        for (int w = 0; w < m_maxThread; ++w) {
+            queues.push_back(std::make_unique<Worker>());
+            queues.back()->rng = 0x9E3779B97F4A7C15ull * (w + 1);
+        }
+        for (int w = 0; w < m_maxThread; ++w) {
+            workers.emplace_back([this, w] { workerLoop(w); });
+        }
+    }
+
+    ~ThreadPool() {
+        std::cout << "Destructor is called" << std::endl;
+        stop.store(true, std::memory_order_release);
+        epoch.fetch_add(1, std::memory_order_release);
+        futexWake(epoch);
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    // Generic enqueue with return support. `f` and `args` are copied or
+    // moved into the task, as by std::thread, and called once.
+    template <class F, class... Args>
+    auto enqueue(F&& f, Args&&... args)
+        -> PoolFuture<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+
+        using return_type = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+
+        auto* state = poolNew<FutureState<return_type>>();
+        submit(makeFutureTask(state, std::forward<F>(f), std::forward<Args>(args)...));
+        return PoolFuture<return_type>(state, executor());
+    }
+
+    // enqueue() into the lane for `options.priority`, ordered by
+    // `options.deadline` within it
+    template <class F, class... Args>
+    auto enqueue(const TaskOptions& options, F&& f, Args&&... args)
+        -> PoolFuture<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+
+        using return_type = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
+
+        auto* state = poolNew<FutureState<return_type>>();
+        submit(makeFutureTask(state, std::forward<F>(f), std::forward<Args>(args)...), options);
+        return PoolFuture<return_type>(state, executor());
+    }
+
+    // Submit-and-forget: no future, no shared state. An exception
+    // escaping `f` terminates the program, as from a std::thread.
+    template <class F, class... Args>
+        requires std::is_invocable_v<std::decay_t<F>, std::decay_t<Args>...>
+    void post(F&& f, Args&&... args) {
+        submit(makeTask(std::forward<F>(f), std::forward<Args>(args)...));
+    }
+
+    template <class F, class... Args>
+    void post(const TaskOptions& options, F&& f, Args&&... args) {
+        submit(makeTask(std::forward<F>(f), std::forward<Args>(args)...), options);
+    }
+
+    // Where then() and when_all / when_any continuations of this
+    // pool's futures are posted
+    FutureExecutor executor() {
+        return {this, [](void* pool, InlineTask&& task) {
+                    static_cast<ThreadPool*>(pool)->submit(poolNew<Task>(std::move(task)));
+                }};
+    }
+
+    size_t size() const { return queues.size(); }
+
+    // The calling thread's worker number, or -1 if it is not one of ours
+    int workerIndex() const { return current_pool == this ? static_cast<int>(current_index) : -1; }
+
+    // Tasks waiting in the calling worker's own deque; 0 off the pool
+    size_t localQueueDepth() const {
+        return current_pool == this ? static_cast<size_t>(queues[current_index]->deque.size()) : 0;
+    }
+
+    // Runs one queued task on the calling thread, if there is one, so a
+    // thread waiting for its own subtasks works instead of blocking. A
+    // worker looks where it normally would; any other thread goes
+    // through the lanes in priority order, taking from the injection
+    // queue or stealing when it reaches Normal work.
+    bool runPendingTask() {
+        Task* task = nullptr;
+        if (current_pool == this) {
+            if (!findTask(current_index, task)) return false;
+        } else if (!lane(TaskPriority::High).tryPop(task) && !lane(TaskPriority::Normal).tryPop(task) &&
+                   !popInjected(task)) {
+            size_t victim = 0;
+            while (victim < queues.size() && !queues[victim]->deque.steal(task)) ++victim;
+            if (victim == queues.size() && !lane(TaskPriority::Low).tryPop(task)) return false;
+        }
+        runTask(task);
+        return true;
+    }
+
+    // A snapshot of one lane. Work submitted without TaskOptions is
+    // Normal: it is included in the Normal depth, but the other Normal
+    // counters only cover work submitted to the lane itself.
+    LaneStats laneStats(TaskPriority priority) {
+        LaneStats stats = lane(priority).stats();
+        if (priority == TaskPriority::Normal) {
+            for (auto& worker : queues) stats.depth += static_cast<size_t>(std::max<int64_t>(worker->deque.size(), 0));
+            stats.depth += injected.size() + overflow_depth.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+};
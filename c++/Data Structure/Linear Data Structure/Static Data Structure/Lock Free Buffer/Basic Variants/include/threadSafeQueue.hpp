@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+// =============================================
+// Lock-Based Queues from main.cpp
+// =============================================
+// The two mutex + condition_variable queues main.cpp is built on, kept
+// as they are there so they can be measured next to the lock-free
+// variants.
+
+// Bounded: push blocks while full, pop blocks while empty. Every push
+// and pop wakes all waiters (notify_all), as in the original.
+template<typename T>
+class ThreadSafeQueue {
+private:
+    std::queue<T> queue;
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    std::atomic<bool> shutdown_flag{false};
+    size_t max_size;
+
+public:
+    explicit ThreadSafeQueue(size_t max_size = 10) : max_size(max_size) {}
+
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]() { return queue.size() < max_size || shutdown_flag.load(); });
+        if (shutdown_flag.load()) return false;
+        queue.push(std::move(item));
+        cond.notify_all();
+        return true;
+    }
+
+    // Returns false once shut down and drained
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]() { return !queue.empty() || shutdown_flag.load(); });
+        if (queue.empty()) return false;
+        item = std::move(queue.front());
+        queue.pop();
+        cond.notify_all();
+        return true;
+    }
+
+    void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            shutdown_flag.store(true);
+        }
+        cond.notify_all();
+    }
+
+    bool is_shutdown() const {
+        return shutdown_flag.load();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size();
+    }
+};
+
+// Unbounded: the global std::queue + mutex + condvar of main.cpp's
+// live producer/consumer. push never blocks and wakes one consumer;
+// close() plays the role of `done_reading`.
+template<typename T>
+class LockedQueue {
+private:
+    std::queue<T> queue;
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+    bool done = false;
+
+public:
+    void push(T item) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(std::move(item));
+        cond.notify_one();
+    }
+
+    // Returns false once closed and drained
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]() { return !queue.empty() || done; });
+        if (queue.empty()) return false;
+        item = std::move(queue.front());
+        queue.pop();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cond.notify_all();
+    }
+
+    size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex);
+        return queue.size();
+    }
+};
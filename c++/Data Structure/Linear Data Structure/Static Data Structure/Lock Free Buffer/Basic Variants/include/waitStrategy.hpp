@@ -0,0 +1,105 @@
+#pragma once
+
+#include "futex.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// =============================================
+// Wait Strategy for Blocking Buffer Operations
+// =============================================
+// A waiting thread first spins for `spin_for` (lowest latency, burns
+// the core), then yields for `yield_for` (lets a peer on the same core
+// run), then either parks in the kernel until the other side signals
+// it (`park == true`) or keeps yielding.
+struct WaitStrategy {
+    std::chrono::nanoseconds spin_for{std::chrono::microseconds(50)};
+    bool park = true;
+    std::chrono::nanoseconds yield_for{0};
+};
+
+// Tells the core we are in a spin loop (saves power, frees the
+// sibling hyper-thread)
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+using WaitClock = std::chrono::steady_clock;
+
+// `timeout` from now, saturating instead of overflowing
+inline WaitClock::time_point deadlineAfter(std::chrono::nanoseconds timeout) {
+    auto now = WaitClock::now();
+    return timeout >= WaitClock::time_point::max() - now ? WaitClock::time_point::max() : now + timeout;
+}
+
+// One direction of wake-ups between threads (or processes) is a futex
+// word `epoch` plus a `waiting` count. A waiter adds itself to the
+// count, fences, then re-checks its condition; the notifier makes
+// progress, fences, then checks the count. At least one of them sees
+// the other, so no wake-up is lost, and the notifier only pays for a
+// syscall when someone is actually parked. Several threads may wait
+// on one direction; each notify wakes one of them.
+
+// Call after every successful operation the peer might be waiting for
+inline void notifyWaiter(std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& waiting,
+                         bool shared = false) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting.load(std::memory_order_relaxed)) {
+        epoch.fetch_add(1, std::memory_order_release);
+        futexWake(epoch, 1, shared);
+    }
+}
+
+// Retries `tryOp` per `strategy` until it succeeds (true) or
+// `deadline` passes (false)
+template<typename TryOp>
+bool waitUntil(TryOp&& tryOp, std::atomic<uint32_t>& epoch, std::atomic<uint32_t>& waiting,
+               WaitClock::time_point deadline, const WaitStrategy& strategy, bool shared = false) {
+    // Phase 1: spin
+    auto spin_until = std::min(deadline, WaitClock::now() + strategy.spin_for);
+    do {
+        if (tryOp()) return true;
+        cpuRelax();
+    } while (WaitClock::now() < spin_until);
+
+    // Phase 2: yield
+    auto yield_until = std::min(deadline, WaitClock::now() + strategy.yield_for);
+    while (WaitClock::now() < yield_until) {
+        if (tryOp()) return true;
+        std::this_thread::yield();
+    }
+
+    // Phase 3: yield or park until the peer signals or time runs out
+    while (true) {
+        if (!strategy.park) {
+            if (tryOp()) return true;
+            if (WaitClock::now() >= deadline) return false;
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint32_t seen = epoch.load(std::memory_order_acquire);
+        waiting.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (tryOp()) {
+            waiting.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        auto now = WaitClock::now();
+        if (now >= deadline) {
+            waiting.fetch_sub(1, std::memory_order_relaxed);
+            return false;
+        }
+        futexWait(epoch, seen, deadline - now, shared);
+        waiting.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "cacheLine.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+// =============================================
+// Chase-Lev Work-Stealing Deque
+// =============================================
+// One owner thread pushes and pops at the bottom (LIFO: the task it
+// just made is the one whose data is still in its cache). Any number
+// of thieves take from the top (FIFO: the oldest task, usually the
+// biggest piece of work left). Owner push/pop are plain loads and
+// stores plus one fence; only the race for the very last item and
+// thieves racing each other go through a CAS on `top`.
+//
+// The array grows when full. Thieves may still be reading the old one,
+// so it is retired, not freed, until the deque is destroyed; growth
+// doubles the size, so the retired arrays add up to less than the live
+// one.
+//
+// Memory orders follow Le, Pop, Cohen and Zappa Nardelli, "Correct
+// and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+// The push publishes `bottom` with release, where the paper has a
+// relaxed store after a release fence, so tools that do not model
+// fences (ThreadSanitizer) see the hand-off too.
+//
+// T must be trivially copyable (a pointer or handle): slots are
+// atomics, and a thief may read one that the owner is about to reuse.
+template<typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "WorkStealingDeque holds pointers or handles");
+
+    struct Array {
+        int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+
+        explicit Array(int64_t capacity) : mask(capacity - 1), slots(new std::atomic<T>[capacity]) {}
+
+        int64_t capacity() const { return mask + 1; }
+        T get(int64_t i) const { return slots[i & mask].load(std::memory_order_relaxed); }
+        void put(int64_t i, T value) { slots[i & mask].store(value, std::memory_order_relaxed); }
+    };
+
+    alignas(cacheLineSize) std::atomic<int64_t> top{0};
+    alignas(cacheLineSize) std::atomic<int64_t> bottom{0};
+    alignas(cacheLineSize) std::atomic<Array*> array;
+    std::vector<std::unique_ptr<Array>> arrays; // live one last; owner only
+
+    Array* grow(Array* old, int64_t t, int64_t b) {
+        auto bigger = std::make_unique<Array>(old->capacity() * 2);
+        for (int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+        Array* raw = bigger.get();
+        arrays.push_back(std::move(bigger));
+        array.store(raw, std::memory_order_release);
+        return raw;
+    }
+
+public:
+    // `capacity` is rounded up to a power of two
+    explicit WorkStealingDeque(int64_t capacity = 256) {
+        int64_t size = 2;
+        while (size < capacity) size <<= 1;
+        arrays.push_back(std::make_unique<Array>(size));
+        array.store(arrays.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Owner only. Never fails; grows instead.
+    void push(T item) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Array* a = array.load(std::memory_order_relaxed);
+        if (b - t > a->mask) a = grow(a, t, b);
+
+        a->put(b, item);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    // Owner only. Takes the newest item; false if empty or a thief got
+    // the last one first.
+    bool pop(T& item) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Array* a = array.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b) { // empty
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = a->get(b);
+        if (t < b) return true; // more than one left: no thief can reach this one
+
+        // Last item: race the thieves for it
+        bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    // Any thread. Takes the oldest item; false if empty or another
+    // thread won the race (the caller may simply try elsewhere).
+    bool steal(T& item) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) return false;
+
+        T candidate = array.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+        item = candidate;
+        return true;
+    }
+
+    // Approximate when called concurrently
+    bool empty() const {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+
+    int64_t size() const {
+        int64_t n = bottom.load(std::memory_order_relaxed) - top.load(std::memory_order_relaxed);
+        return n > 0 ? n : 0;
+    }
+};
@@ -0,0 +1,201 @@
+#include "asyncFileIo.hpp"
+#include "caseConversion.hpp"
+#include "mpmcQueue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// =============================================
+// Upper-Casing Pipeline with Asynchronous I/O
+// =============================================
+// One I/O thread keeps up to `depth` reads and writes in flight on the
+// fixed buffers of an AsyncFileIo (io_uring, or a pread/pwritev thread
+// as fallback). Transform threads upper-case whole buffers in place.
+//
+//   free buffer --read--> to_transform --upper-case--> transformed
+//        ^                                                  |
+//        +------------------------ write <------------------+
+//
+// Upper-casing keeps the length, so each buffer is written back at the
+// offset it was read from: no reorder stage, and reads of later chunks
+// overlap with transforms and writes of earlier ones. The I/O thread
+// sleeps in complete() until an I/O finishes or a transform thread
+// wakes it with a finished buffer.
+//
+// Usage: AsyncFileProcessor [input] [output] [transform_threads] [auto|uring|threaded]
+
+struct Job {
+    uint64_t offset = 0;
+    size_t length = 0;
+    size_t done = 0;     // bytes of the current read/write finished
+    bool writing = false;
+};
+
+class AsyncPipeline {
+    int input_fd;
+    int output_fd;
+    uint64_t input_size;
+    std::unique_ptr<AsyncFileIo> io;
+    std::vector<Job> jobs;
+
+    MpmcQueue<size_t> to_transform;
+    MpmcQueue<size_t> transformed;
+
+    void submit(size_t index) {
+        Job& job = jobs[index];
+        if (job.writing) {
+            io->submitWrite(output_fd, index, job.done, job.length - job.done, job.offset + job.done, index);
+        } else {
+            io->submitRead(input_fd, index, job.done, job.length - job.done, job.offset + job.done, index);
+        }
+    }
+
+public:
+    AsyncPipeline(int input_fd, int output_fd, uint64_t input_size, std::unique_ptr<AsyncFileIo> io)
+        : input_fd(input_fd), output_fd(output_fd), input_size(input_size), io(std::move(io)),
+          jobs(this->io->bufferCount()),
+          to_transform(this->io->bufferCount()), transformed(this->io->bufferCount()) {}
+
+    void transformer() {
+        size_t index;
+        while (to_transform.pop(index)) {
+            toUpperInPlace(io->buffer(index), jobs[index].length);
+            transformed.push(index);
+            io->wake();
+        }
+    }
+
+    void run(size_t transform_threads) {
+        if (transform_threads == 0) throw std::runtime_error("Need at least one transform thread");
+
+        // Closes the transform queue and joins its threads on every way
+        // out of run(), so an I/O error reaches the caller as an exception
+        struct Workers {
+            MpmcQueue<size_t>& queue;
+            std::vector<std::thread> threads;
+
+            ~Workers() {
+                queue.shutdown();
+                for (auto& w : threads) w.join();
+            }
+        } workers{to_transform, {}};
+        for (size_t i = 0; i < transform_threads; ++i) {
+            workers.threads.emplace_back([this]() { this->transformer(); });
+        }
+
+        std::vector<size_t> free_buffers;
+        for (size_t i = 0; i < jobs.size(); ++i) free_buffers.push_back(i);
+
+        std::vector<AsyncFileIo::Completion> completions(jobs.size());
+        uint64_t next_offset = 0;
+        size_t in_flight = 0;     // reads + writes submitted to `io`
+        size_t transforming = 0;  // buffers with the transform threads
+
+        while (true) {
+            // Fill every free buffer with the next part of the input
+            while (!free_buffers.empty() && next_offset < input_size) {
+                size_t index = free_buffers.back();
+                free_buffers.pop_back();
+                jobs[index] = {next_offset, static_cast<size_t>(std::min<uint64_t>(io->bufferSize(), input_size - next_offset)), 0, false};
+                next_offset += jobs[index].length;
+                submit(index);
+                ++in_flight;
+            }
+
+            // Write back whatever the transform threads have finished
+            size_t index;
+            while (transformed.try_pop(index)) {
+                --transforming;
+                jobs[index].writing = true;
+                jobs[index].done = 0;
+                submit(index);
+                ++in_flight;
+            }
+
+            if (in_flight == 0 && transforming == 0 && next_offset >= input_size) break;
+
+            // Sleep until an I/O completes or a transform is handed back
+            size_t n = io->complete(completions, 1);
+
+            for (size_t i = 0; i < n; ++i) {
+                --in_flight;
+                Job& job = jobs[completions[i].tag];
+                if (completions[i].result < 0) {
+                    throw std::runtime_error(std::string(job.writing ? "write" : "read") + " failed: " +
+                                             std::strerror(static_cast<int>(-completions[i].result)));
+                }
+                if (completions[i].result == 0) {
+                    throw std::runtime_error("Input file shrank while processing");
+                }
+
+                job.done += static_cast<size_t>(completions[i].result);
+                if (job.done < job.length) { // short transfer: finish the rest
+                    submit(completions[i].tag);
+                    ++in_flight;
+                } else if (!job.writing) {
+                    ++transforming;
+                    to_transform.push(completions[i].tag);
+                } else {
+                    free_buffers.push_back(completions[i].tag);
+                }
+            }
+        }
+    }
+};
+
+int main(int argc, char* argv[]) {
+    const std::string input_path = argc > 1 ? argv[1] : "input.txt";
+    const std::string output_path = argc > 2 ? argv[2] : "output.txt";
+    const size_t transform_threads = argc > 3 ? std::stoul(argv[3]) : 4;
+    const std::string backend = argc > 4 ? argv[4] : "auto";
+    const size_t depth = 16;              // buffers in flight
+    const size_t chunk_size = 64 * 1024;  // bytes per buffer
+
+    try {
+        int input_fd = open(input_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (input_fd < 0) throw std::runtime_error("Failed to open input file");
+        int output_fd = open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (output_fd < 0) throw std::runtime_error("Failed to open output file");
+
+        struct stat st {};
+        if (fstat(input_fd, &st) != 0) throw std::runtime_error("Failed to stat input file");
+
+        std::unique_ptr<AsyncFileIo> io;
+        if (backend == "uring") {
+#ifdef ASYNC_FILE_IO_URING
+            io = std::make_unique<IoUringFileIo>(depth, chunk_size);
+#else
+            throw std::runtime_error("Built without io_uring headers");
+#endif
+        } else {
+            io = makeAsyncFileIo(depth, chunk_size, backend != "threaded");
+        }
+        std::cout << "I/O backend: " << io->name() << ", " << depth << " x "
+                  << chunk_size / 1024 << " KB buffers, " << transform_threads << " transform threads" << std::endl;
+
+        auto start = std::chrono::steady_clock::now();
+        AsyncPipeline pipeline(input_fd, output_fd, static_cast<uint64_t>(st.st_size), std::move(io));
+        pipeline.run(transform_threads);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        close(input_fd);
+        close(output_fd);
+        std::cout << "Processed " << st.st_size << " bytes in " << seconds << " s ("
+                  << st.st_size / seconds / 1e6 << " MB/s). Output saved to " << output_path << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
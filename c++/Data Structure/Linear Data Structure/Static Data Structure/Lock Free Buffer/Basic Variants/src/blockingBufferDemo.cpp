@@ -0,0 +1,87 @@
+#include "blockingRingBuffer.hpp"
+#include "lockFreeBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// =============================================
+// Hand-off Latency: sleep-polling vs push_wait/pop_wait
+// =============================================
+// The producer sends a timestamp every `gap`; the consumer records how
+// long each one took to arrive. The polling consumer is the
+// waitingBuffer.cpp loop with a 100 us sleep instead of 1 s.
+
+using Clock = std::chrono::steady_clock;
+constexpr size_t buffer_size = 64;
+
+void report(const char* name, std::vector<double>& latencies_us) {
+    std::sort(latencies_us.begin(), latencies_us.end());
+    auto at = [&](double q) { return latencies_us[static_cast<size_t>(q * (latencies_us.size() - 1))]; };
+    std::cout << name << ": p50 " << at(0.50) << " us, p99 " << at(0.99)
+              << " us, max " << latencies_us.back() << " us\n";
+}
+
+template<typename Send, typename Receive>
+std::vector<double> measure(size_t messages, std::chrono::microseconds gap, Send send, Receive receive) {
+    std::vector<double> latencies_us;
+    latencies_us.reserve(messages);
+
+    std::thread producer([&]() {
+        for (size_t i = 0; i < messages; ++i) {
+            std::this_thread::sleep_for(gap);
+            send(Clock::now());
+        }
+    });
+
+    for (size_t i = 0; i < messages; ++i) {
+        Clock::time_point sent = receive();
+        latencies_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sent).count());
+    }
+    producer.join();
+    return latencies_us;
+}
+
+int main() {
+    const size_t messages = 2000;
+    const auto gap = std::chrono::microseconds(200);
+
+    {
+        LockFreeBuffer<Clock::time_point, buffer_size> buffer;
+        auto latencies = measure(messages, gap,
+            [&](Clock::time_point t) { while (!buffer.push(t)) std::this_thread::sleep_for(std::chrono::microseconds(100)); },
+            [&]() {
+                Clock::time_point t;
+                while (!buffer.pop(t)) std::this_thread::sleep_for(std::chrono::microseconds(100));
+                return t;
+            });
+        report("sleep-polling (100 us)", latencies);
+    }
+
+    {
+        BlockingRingBuffer<Clock::time_point, buffer_size> buffer;
+        auto latencies = measure(messages, gap,
+            [&](Clock::time_point t) { buffer.push_wait(t); },
+            [&]() {
+                Clock::time_point t;
+                buffer.pop_wait(t);
+                return t;
+            });
+        report("spin + futex park      ", latencies);
+    }
+
+    {
+        // Nobody consumes: push_wait must give up after the timeout
+        BlockingRingBuffer<int, 4> buffer(WaitStrategy{std::chrono::microseconds(10), true});
+        int pushed = 0;
+        auto start = Clock::now();
+        while (buffer.push_wait(pushed, std::chrono::milliseconds(20))) ++pushed;
+        auto waited = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        std::cout << "push_wait on a full buffer: " << pushed << " pushed, gave up after "
+                  << waited << " ms\n";
+    }
+
+    return 0;
+}
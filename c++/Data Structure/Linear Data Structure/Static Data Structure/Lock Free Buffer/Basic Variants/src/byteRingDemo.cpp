@@ -0,0 +1,120 @@
+#include "doubleMappedRingBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// =============================================
+// Byte Stream through a Double-Mapped Ring
+// =============================================
+// Producer: read() from the input file straight into ring memory.
+// Consumer: find whole lines with memchr on ring memory, upper-case
+// them in place and write() them out, never splitting at the wrap.
+//
+// Usage: ByteRingDemo [input] [output]
+// Without an input file, a generated text stream is used.
+
+int main(int argc, char* argv[]) {
+    const char* input_path = argc > 1 ? argv[1] : nullptr;
+    const char* output_path = argc > 2 ? argv[2] : "output.txt";
+
+    DoubleMappedRingBuffer ring(64 * 1024);
+    std::cout << "Ring capacity: " << ring.capacity() << " bytes\n";
+
+    int in = input_path ? open(input_path, O_RDONLY) : -1;
+    if (input_path && in < 0) {
+        std::cerr << "Error: Failed to open input file" << std::endl;
+        return 1;
+    }
+    int out = open(output_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out < 0) {
+        std::cerr << "Error: Failed to open output file" << std::endl;
+        return 1;
+    }
+
+    std::atomic<bool> done{false};
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&]() {
+        const std::string line = "the quick brown fox jumps over the lazy dog\n";
+        size_t generated = 0;
+        const size_t generate_bytes = 64 * 1024 * 1024;
+
+        while (true) {
+            auto space = ring.writable();
+            if (space.empty()) {
+                std::this_thread::yield(); // wait if ring is full
+                continue;
+            }
+
+            ssize_t n;
+            if (in >= 0) {
+                n = ::read(in, space.data(), space.size());
+            } else {
+                n = static_cast<ssize_t>(std::min(space.size(), generate_bytes - generated));
+                for (ssize_t i = 0; i < n; ++i) {
+                    space[i] = line[(generated + i) % line.size()];
+                }
+                generated += n;
+            }
+            if (n <= 0) break;
+            ring.produce(static_cast<size_t>(n));
+        }
+        done.store(true, std::memory_order_release);
+    });
+
+    size_t bytes = 0, lines = 0;
+    while (true) {
+        bool finished = done.load(std::memory_order_acquire);
+        auto data = ring.readable();
+
+        // Only whole lines, unless the producer is finished
+        const char* end = data.data() + data.size();
+        const char* last_newline = nullptr;
+        for (const char* p = data.data(); p < end;) {
+            auto* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!nl) break;
+            ++lines;
+            last_newline = nl;
+            p = nl + 1;
+        }
+        size_t take = finished ? data.size() : (last_newline ? last_newline + 1 - data.data() : 0);
+
+        if (take == 0) {
+            if (finished) break;
+            std::this_thread::yield(); // wait if ring is empty
+            continue;
+        }
+
+        char* chunk = data.data();
+        for (size_t i = 0; i < take; ++i) {
+            if (chunk[i] >= 'a' && chunk[i] <= 'z') chunk[i] -= 'a' - 'A';
+        }
+        for (size_t written = 0; written < take;) {
+            ssize_t n = ::write(out, chunk + written, take - written);
+            if (n <= 0) {
+                std::cerr << "Error: write failed" << std::endl;
+                return 1;
+            }
+            written += static_cast<size_t>(n);
+        }
+        ring.consume(take);
+        bytes += take;
+    }
+
+    producer.join();
+    if (in >= 0) close(in);
+    close(out);
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Processed " << bytes << " bytes, " << lines << " lines in " << seconds << " s ("
+              << bytes / seconds / 1e6 << " MB/s). Output saved to " << output_path << std::endl;
+    return 0;
+}
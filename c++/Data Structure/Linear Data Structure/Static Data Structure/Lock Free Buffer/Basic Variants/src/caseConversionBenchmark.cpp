@@ -0,0 +1,82 @@
+#include "caseConversion.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+// =============================================
+// Upper-Casing Throughput (GB/s)
+// =============================================
+// Baseline is the TextProcessor::toUpperCase loop from main.cpp:
+// std::toupper per byte, appended one character at a time.
+
+std::string perCharacterLoop(const std::string& input) {
+    std::string output;
+    output.reserve(input.size());
+    for (char c : input) {
+        output += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+    }
+    return output;
+}
+
+template<typename Fn>
+double gigabytesPerSecond(size_t bytes, int rounds, Fn fn) {
+    double best = 0;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::max(best, bytes / seconds / 1e9);
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    const size_t size = argc > 1 ? std::stoull(argv[1]) : 64ull * 1024 * 1024;
+    const int rounds = 5;
+
+    // Printable text with a realistic mix of cases and punctuation
+    std::mt19937 rng(42);
+    std::string text(size, ' ');
+    const std::string alphabet = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789 ,.;\n";
+    for (char& c : text) c = alphabet[rng() % alphabet.size()];
+
+    const std::string expected = perCharacterLoop(text);
+    std::string work = text;
+
+    auto check = [&](const char* name) {
+        if (work != expected) {
+            std::cerr << name << " produced wrong output" << std::endl;
+            std::exit(1);
+        }
+    };
+
+    std::cout << "Upper-casing " << size / (1024 * 1024) << " MB, best of " << rounds << "\n";
+
+    std::string sink;
+    double baseline = gigabytesPerSecond(size, rounds, [&]() { sink = perCharacterLoop(text); });
+    std::cout << "  per-character loop : " << baseline << " GB/s\n";
+
+    // The kernels are branch-free, so re-running them on already
+    // converted text costs the same and only the kernel is timed
+    auto run = [&](const char* name, ToUpperKernel kernel) {
+        work = text;
+        double gbps = gigabytesPerSecond(size, rounds, [&]() { kernel(work.data(), work.size()); });
+        check(name);
+        std::cout << "  " << name << gbps << " GB/s  (x" << gbps / baseline << ")\n";
+    };
+
+    run("scalar in place    : ", toUpperScalar);
+#ifdef CASE_CONVERSION_X86
+    run("SSE2               : ", toUpperSse2);
+    if (__builtin_cpu_supports("avx2")) run("AVX2               : ", toUpperAvx2);
+    if (__builtin_cpu_supports("avx512bw")) run("AVX-512            : ", toUpperAvx512);
+#endif
+    std::cout << "Dispatch picks: " << toUpperDispatch().name << "\n";
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include "futureCombinators.hpp"
+#include "threadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =============================================
+// Composing Pool Futures: get() vs then() / when_all
+// =============================================
+// Every job fans out `leaves` tasks, sums their results, then scales
+// the sum in one more step: three dependent stages. Done three ways:
+//   get() per job     the main thread enqueues the leaves, get()s each
+//                     one, enqueues the next stage and get()s that, as
+//                     in Futures/asyncFuture.cpp and Thread Pool/main.cpp
+//   get() in a task   each job is a pool task that get()s its leaves.
+//                     Those workers park; once every worker is such a
+//                     job, the leaves queued behind them never run. So
+//                     only threads - 1 jobs may be in flight at a time
+//   then / when_all   every job is a chain of continuations. All jobs
+//                     are in flight at once and no thread waits, except
+//                     main for the final when_all
+// Results are checked against a serial run.
+//
+// Usage: ContinuationDemo [jobs] [threads]
+
+constexpr int leaves = 8;
+constexpr int leaf_size = 2000;
+
+double leafWork(int job, int leaf) {
+    double sum = 0;
+    for (int i = 0; i < leaf_size; ++i) sum += std::sqrt(static_cast<double>(job * leaves + leaf + i));
+    return sum;
+}
+
+double finish(double sum) { return sum / leaves; }
+
+template<typename Fn>
+double milliseconds(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void check(const std::vector<double>& results, const std::vector<double>& expected, const char* what) {
+    if (results != expected) {
+        std::fprintf(stderr, "%s: wrong result\n", what);
+        std::exit(1);
+    }
+}
+
+// The blocking job: runs on a worker and parks it in get()
+double blockingJob(ThreadPool& pool, int job) {
+    std::vector<PoolFuture<double>> parts;
+    for (int leaf = 0; leaf < leaves; ++leaf) parts.push_back(pool.enqueue(leafWork, job, leaf));
+    double sum = 0;
+    for (auto& part : parts) sum += part.get();
+    return finish(sum);
+}
+
+// The same job as a chain: fan out, when_all, then two more steps
+PoolFuture<double> chainedJob(ThreadPool& pool, int job) {
+    std::vector<PoolFuture<double>> parts;
+    for (int leaf = 0; leaf < leaves; ++leaf) parts.push_back(pool.enqueue(leafWork, job, leaf));
+    return when_all(std::move(parts))
+        .then([](std::vector<PoolFuture<double>> ready) {
+            double sum = 0;
+            for (auto& part : ready) sum += part.get();
+            return sum;
+        })
+        .then(finish);
+}
+
+int main(int argc, char* argv[]) {
+    const int jobs = argc > 1 ? std::stoi(argv[1]) : 20'000;
+    const int threads = argc > 2 ? std::stoi(argv[2]) : std::max(4u, std::thread::hardware_concurrency());
+
+    std::vector<double> expected(jobs);
+    for (int job = 0; job < jobs; ++job) {
+        double sum = 0;
+        for (int leaf = 0; leaf < leaves; ++leaf) sum += leafWork(job, leaf);
+        expected[job] = finish(sum);
+    }
+
+    ThreadPool pool(std::max(threads, 2));
+    std::vector<double> results(jobs);
+
+    double per_job = milliseconds([&]() {
+        for (int job = 0; job < jobs; ++job) {
+            std::vector<PoolFuture<double>> parts;
+            for (int leaf = 0; leaf < leaves; ++leaf) parts.push_back(pool.enqueue(leafWork, job, leaf));
+            double sum = 0;
+            for (auto& part : parts) sum += part.get();
+            results[job] = pool.enqueue(finish, sum).get();
+        }
+    });
+    check(results, expected, "get() per job");
+
+    double in_task = milliseconds([&]() {
+        const size_t in_flight = static_cast<size_t>(std::max(threads, 2) - 1);
+        std::vector<PoolFuture<double>> window;
+        int next_result = 0;
+        for (int job = 0; job < jobs; ++job) {
+            if (window.size() == in_flight) {
+                results[next_result++] = window.front().get();
+                window.erase(window.begin());
+            }
+            window.push_back(pool.enqueue([&pool, job] { return blockingJob(pool, job); }));
+        }
+        for (auto& fut : window) results[next_result++] = fut.get();
+    });
+    check(results, expected, "get() in a task");
+
+    double chained = milliseconds([&]() {
+        std::vector<PoolFuture<double>> all;
+        all.reserve(jobs);
+        for (int job = 0; job < jobs; ++job) all.push_back(chainedJob(pool, job));
+        auto ready = when_all(std::move(all)).get();
+        for (int job = 0; job < jobs; ++job) results[job] = ready[job].get();
+    });
+    check(results, expected, "then / when_all");
+
+    std::printf("%d jobs of %d leaves, %d threads (ms)\n", jobs, leaves, std::max(threads, 2));
+    std::printf("  get() per job    %8.2f\n", per_job);
+    std::printf("  get() in a task  %8.2f   (%d jobs in flight)\n", in_task, std::max(threads, 2) - 1);
+    std::printf("  then / when_all  %8.2f\n", chained);
+    return 0;
+}
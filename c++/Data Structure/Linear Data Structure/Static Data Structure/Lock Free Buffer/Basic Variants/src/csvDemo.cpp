@@ -0,0 +1,125 @@
+#include "csvParser.hpp"
+#include "mappedFile.hpp"
+#include "pipeline.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// =============================================
+// CSV Demo: people.txt into Columns
+// =============================================
+// Repeats people.txt `copies` times in memory, then:
+//  1. times the structural kernels on the whole text and checks that
+//     every kernel yields the same columns;
+//  2. runs it through a Pipeline: ~64KB line-aligned slices go to a
+//     Parallel "parse" stage that makes PersonBatch columns, and the
+//     sink aggregates the age column batch by batch.
+//
+// Usage: CsvDemo [people.txt] [copies] [min age]
+
+template<typename Fn>
+double gigabytesPerSecond(size_t bytes, int rounds, Fn fn) {
+    double best = 0;
+    for (int r = 0; r < rounds; ++r) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        best = std::max(best, bytes / seconds / 1e9);
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        const std::string path = argc > 1 ? argv[1] : "../people.txt";
+        const size_t copies = argc > 2 ? std::stoull(argv[2]) : 200'000;
+        const uint32_t min_age = argc > 3 ? static_cast<uint32_t>(std::stoul(argv[3])) : 30;
+        const int rounds = 5;
+
+        MappedFile file(path);
+        std::string one(file.view());
+        if (!one.empty() && one.back() != '\n') one += '\n';
+        std::string text;
+        text.reserve(one.size() * copies);
+        for (size_t i = 0; i < copies; ++i) text += one;
+
+        std::cout << "Parsing " << text.size() / (1024.0 * 1024.0) << " MB (" << copies << " x " << path
+                  << "), best of " << rounds << "\n";
+
+        CsvParser reference_parser(',', findStructuralsScalar);
+        PersonBatch expected;
+        parsePeople(reference_parser, text, expected);
+
+        auto run = [&](const char* name, StructuralKernel kernel) {
+            CsvParser parser(',', kernel);
+            PersonBatch batch;
+            double gbps = gigabytesPerSecond(text.size(), rounds, [&]() { parsePeople(parser, text, batch); });
+            if (batch.age != expected.age || batch.name_offset != expected.name_offset ||
+                batch.phone_offset != expected.phone_offset) {
+                std::cerr << name << " produced different columns" << std::endl;
+                std::exit(1);
+            }
+            std::cout << "  " << name << gbps << " GB/s\n";
+        };
+
+        run("scalar  : ", findStructuralsScalar);
+#ifdef CSV_PARSER_X86
+        run("SSE2    : ", findStructuralsSse2);
+        if (__builtin_cpu_supports("avx2")) run("AVX2    : ", findStructuralsAvx2);
+        if (__builtin_cpu_supports("avx512bw")) run("AVX-512 : ", findStructuralsAvx512);
+#endif
+        std::cout << "Dispatch picks: " << structuralDispatch().name << "\n";
+
+        // Column-at-a-time aggregation downstream of a parallel parse
+        const size_t slice_size = 64 * 1024;
+        LineRanges ranges(text, (text.size() + slice_size - 1) / slice_size);
+        size_t next_range = 0;
+        uint64_t rows = 0, age_sum = 0, at_least = 0, rejected = 0;
+
+        Pipeline pipeline;
+        pipeline
+            .source<std::string_view>("slice", [&]() -> std::optional<std::string_view> {
+                if (next_range >= ranges.size()) return std::nullopt;
+                return ranges[next_range++];
+            })
+            .stage<PersonBatch>("parse", StageMode::Parallel, std::max(2u, std::thread::hardware_concurrency()),
+                                [](std::string_view slice) -> std::optional<PersonBatch> {
+                thread_local CsvParser parser;
+                PersonBatch batch;
+                parsePeople(parser, slice, batch);
+                return batch;
+            })
+            .sink("aggregate", StageMode::SerialOutOfOrder, 1, [&](PersonBatch batch) {
+                rows += batch.size();
+                rejected += batch.rejected;
+                for (uint32_t age : batch.age) {
+                    age_sum += age;
+                    at_least += age >= min_age;
+                }
+            });
+        PipelineReport report = pipeline.run();
+
+        std::cout << rows << " people, mean age " << (rows ? static_cast<double>(age_sum) / rows : 0.0) << ", "
+                  << at_least << " aged " << min_age << "+, " << rejected << " rows rejected\n";
+        report.print(std::cout);
+
+        std::cout << "Aged " << min_age << "+ in " << path << ":\n";
+        PersonBatch first;
+        parsePeople(reference_parser, one, first);
+        for (size_t i = 0; i < first.size(); ++i) {
+            if (first.age[i] >= min_age) std::cout << "  " << first.name(i) << " (" << first.phone(i) << ")\n";
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
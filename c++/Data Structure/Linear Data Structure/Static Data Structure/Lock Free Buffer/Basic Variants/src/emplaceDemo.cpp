@@ -0,0 +1,67 @@
+#include "lockFreeRingBuffer.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <thread>
+
+// =============================================
+// Raw Slots: Move-Only Items, No Up-Front Construction
+// =============================================
+// 1. std::unique_ptr<Chunk> through the ring: the producer emplaces,
+//    the consumer moves the pointer out; the 4 KB chunk never moves.
+// 2. A type with no default constructor that counts its instances:
+//    an empty ring holds none, and the count follows the live items.
+
+struct Chunk {
+    uint64_t index;
+    std::array<char, 4096> bytes;
+};
+
+struct Tracked {
+    static inline std::atomic<int> live{0};
+    uint64_t value;
+
+    explicit Tracked(uint64_t value) : value(value) { ++live; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+    Tracked& operator=(Tracked&& other) noexcept { value = other.value; return *this; }
+    ~Tracked() { --live; }
+};
+
+int main() {
+    constexpr uint64_t chunks = 100000;
+    LockFreeRingBuffer<std::unique_ptr<Chunk>, 64> ring;
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < chunks; ++i) {
+            auto chunk = std::make_unique<Chunk>();
+            chunk->index = i;
+            while (!ring.push(std::move(chunk))) std::this_thread::yield();
+        }
+    });
+
+    for (uint64_t i = 0; i < chunks; ++i) {
+        std::optional<std::unique_ptr<Chunk>> chunk;
+        while (!(chunk = ring.pop())) std::this_thread::yield();
+        if ((*chunk)->index != i) {
+            std::cerr << "Order broken at " << i << std::endl;
+            return 1;
+        }
+    }
+    producer.join();
+    std::cout << "Moved " << chunks << " unique_ptr<Chunk> through the ring\n";
+
+    {
+        LockFreeRingBuffer<Tracked, 1024> tracked;
+        std::cout << "Empty ring of 1024 slots: " << Tracked::live << " live Tracked\n";
+        for (uint64_t i = 0; i < 10; ++i) tracked.emplace(i);
+        std::cout << "After 10 emplace:        " << Tracked::live << " live Tracked\n";
+        for (int i = 0; i < 4; ++i) tracked.pop();
+        std::cout << "After 4 pop:             " << Tracked::live << " live Tracked\n";
+    }
+    std::cout << "Ring destroyed:          " << Tracked::live << " live Tracked\n";
+    return 0;
+}
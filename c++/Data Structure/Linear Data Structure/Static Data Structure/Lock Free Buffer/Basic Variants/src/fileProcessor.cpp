@@ -0,0 +1,198 @@
+#include "caseConversion.hpp"
+#include "chunkPool.hpp"
+#include "coalescingWriter.hpp"
+#include "mappedFile.hpp"
+#include "reorderBuffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// =============================================
+// Parallel Upper-Casing File Pipeline
+// =============================================
+// The ProducerConsumerManager design from main.cpp, made safe for
+// several producer threads:
+//  * the input is memory-mapped and cut into ~chunk_size ranges that
+//    end on a newline; a producer claims the next range number with
+//    one atomic increment and works on a string_view of it, so there
+//    is no shared stream and no lock on the read side;
+//  * the upper-casing runs on all producers at once;
+//  * a ReorderBuffer hands chunks to the single writer in file order,
+//    so the output is byte-for-byte the input, upper-cased;
+//  * the writer coalesces chunks into one writev per batch (see
+//    coalescingWriter.hpp) rather than write + flush per chunk, and
+//    syncs to disk only as the Durability policy says;
+//  * chunk buffers come from a ChunkPool and go back to it once
+//    written, so after warm-up the pipeline allocates nothing.
+
+class TextProcessor {
+public:
+    // SIMD kernel picked at startup (see caseConversion.hpp)
+    static void toUpperCaseInPlace(std::string& text) {
+        toUpperInPlace(text.data(), text.size());
+    }
+
+    static void toUpperCaseInPlace(PooledChunk& chunk) {
+        toUpperInPlace(chunk.data, chunk.size);
+    }
+
+    static std::string toUpperCase(const std::string& input) {
+        std::string output = input;
+        toUpperCaseInPlace(output);
+        return output;
+    }
+};
+
+class ProducerConsumerManager {
+private:
+    ReorderBuffer<PooledChunk*> buffer;
+    MappedFile input_file;
+    int output_fd = -1;
+    WritePolicy write_policy;
+    uint64_t writev_calls = 0;
+    std::exception_ptr write_error; // set by the writer thread, rethrown by run()
+    const size_t chunk_size = 4096; // ~4KB chunks, cut at line ends
+    const size_t producer_count;
+    ChunkPool pool;
+
+    LineRanges ranges;
+    std::atomic<uint64_t> next_range{0};
+
+    // Claims the next range; its index is its position in the output
+    bool readNext(uint64_t& sequence, std::string_view& slice) {
+        sequence = next_range.fetch_add(1, std::memory_order_relaxed);
+        if (sequence >= ranges.size()) return false;
+        slice = ranges[sequence];
+        return true;
+    }
+
+public:
+    ProducerConsumerManager(const std::string& input_path, const std::string& output_path, size_t buffer_size,
+                            size_t producer_threads, WritePolicy policy = {})
+        : buffer(buffer_size),
+          input_file(input_path),
+          write_policy(policy),
+          producer_count(producer_threads),
+          // Room for the reorder window, one chunk per producer and a
+          // full write batch: acquire() never has to wait for a flush.
+          // Ranges run past chunk_size to the next newline, hence 2x.
+          pool(buffer_size + producer_count + write_policy.max_batch_chunks, 2 * chunk_size),
+          ranges(input_file.view(), (input_file.view().size() + chunk_size - 1) / chunk_size) {
+        if (producer_count == 0) throw std::runtime_error("Need at least one producer thread");
+        output_fd = ::open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (output_fd < 0) {
+            throw std::runtime_error("Failed to open output file");
+        }
+    }
+
+    ~ProducerConsumerManager() {
+        buffer.close();
+        pool.shutdown();
+        if (output_fd >= 0) ::close(output_fd);
+    }
+
+    void producer() {
+        uint64_t sequence;
+        std::string_view slice;
+        while (readNext(sequence, slice)) {
+            PooledChunk* chunk = pool.acquire();
+            if (!chunk) break;
+            pool.assign(*chunk, slice); // the mapping is read-only
+            TextProcessor::toUpperCaseInPlace(*chunk);
+            if (!buffer.insert(sequence, chunk)) {
+                pool.release(chunk);
+                break;
+            }
+        }
+    }
+
+    // Waits no longer than the oldest pending chunk may wait, so a
+    // partial batch still goes out after max_delay when input is slow.
+    // A write error stops the producers and is kept for run().
+    void consumer() {
+        try {
+            CoalescingWriter<PooledChunk*> writer(output_fd, write_policy,
+                                                  [this](PooledChunk*& written) { pool.release(written); });
+            PooledChunk* chunk = nullptr;
+            while (true) {
+                if (buffer.pop_wait(chunk, writer.timeUntilDue())) {
+                    writer.append(chunk);
+                    continue;
+                }
+                if (buffer.finished()) break;
+                writer.flushIfDue();
+            }
+            writer.close();
+            writev_calls = writer.writevCalls();
+        } catch (...) {
+            write_error = std::current_exception();
+            buffer.close();
+            pool.shutdown();
+        }
+    }
+
+    // Ordered output needs exactly one writer; parallelism goes to the
+    // producers, where the work is.
+    void run() {
+        std::thread writer([this]() { this->consumer(); });
+
+        std::vector<std::thread> producers;
+        producers.reserve(producer_count);
+        for (size_t i = 0; i < producer_count; ++i) {
+            producers.emplace_back([this]() { this->producer(); });
+        }
+        for (auto& p : producers) p.join();
+
+        buffer.close(); // every chunk is in; writer drains and stops
+        writer.join();
+        if (write_error) std::rethrow_exception(write_error);
+    }
+
+    uint64_t writevCalls() const { return writev_calls; }
+    uint64_t chunkGrows() const { return pool.grows(); }
+};
+
+int main(int argc, char* argv[]) {
+    try {
+        const std::string input_file = argc > 1 ? argv[1] : "input.txt";
+        const std::string output_file = argc > 2 ? argv[2] : "output.txt";
+        const size_t buffer_size = 20; // Number of chunks in flight
+        const size_t producer_threads = argc > 3 ? std::stoul(argv[3]) : 4;
+        const std::string durability = argc > 4 ? argv[4] : "close"; // none | close | batch
+
+        WritePolicy policy;
+        if (durability == "none") {
+            policy.durability = Durability::None;
+        } else if (durability == "batch") {
+            policy.durability = Durability::EveryBatch;
+        } else if (durability != "close") {
+            throw std::runtime_error("Durability must be none, close or batch");
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        ProducerConsumerManager manager(input_file, output_file, buffer_size, producer_threads, policy);
+        manager.run();
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "File processing completed successfully in " << seconds << " s ("
+                  << manager.writevCalls() << " writev calls, " << manager.chunkGrows()
+                  << " chunk buffers grown)." << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "mpmcQueue.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// =============================================
+// MpmcQueue with 4 producers and 4 consumers
+// =============================================
+// Same shape as ProducerConsumerManager::run in main.cpp. Each item
+// encodes (producer id, sequence); consumers check that items from one
+// producer arrive in order and that every item is seen exactly once.
+
+int main() {
+    const size_t producer_threads = 4;
+    const size_t consumer_threads = 4;
+    const uint64_t items_per_producer = 1'000'000;
+
+    MpmcQueue<uint64_t> queue(1024);
+    std::vector<std::atomic<uint64_t>> received(producer_threads);
+    std::atomic<bool> order_ok{true};
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> producers;
+    for (uint64_t p = 0; p < producer_threads; ++p) {
+        producers.emplace_back([&, p]() {
+            for (uint64_t i = 0; i < items_per_producer; ++i) {
+                queue.push((p << 32) | i);
+            }
+        });
+    }
+
+    std::vector<std::thread> consumers;
+    for (size_t c = 0; c < consumer_threads; ++c) {
+        consumers.emplace_back([&]() {
+            std::vector<int64_t> last(producer_threads, -1);
+            uint64_t item;
+            while (queue.pop(item)) {
+                uint64_t p = item >> 32;
+                int64_t seq = static_cast<int64_t>(item & 0xffffffff);
+                if (seq <= last[p]) order_ok = false;
+                last[p] = seq;
+                received[p].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (auto& t : producers) t.join();
+    queue.shutdown();
+    for (auto& t : consumers) t.join();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    bool count_ok = true;
+    for (auto& r : received) {
+        if (r.load() != items_per_producer) count_ok = false;
+    }
+
+    uint64_t total = producer_threads * items_per_producer;
+    std::cout << "Transferred " << total << " items in " << seconds << " s ("
+              << total / seconds / 1e6 << " M ops/s)\n"
+              << "Per-producer order: " << (order_ok ? "OK" : "BROKEN") << "\n"
+              << "Item count: " << (count_ok ? "OK" : "BROKEN") << std::endl;
+
+    return order_ok && count_ok ? 0 : 1;
+}
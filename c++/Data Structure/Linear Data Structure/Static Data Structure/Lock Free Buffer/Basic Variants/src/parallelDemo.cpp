@@ -0,0 +1,139 @@
+#include "parallelAlgorithms.hpp"
+#include "threadPool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =============================================
+// parallel_for / parallel_reduce / parallel_invoke
+// =============================================
+// The same loops three ways:
+//   serial            a plain for loop
+//   enqueue per item  one enqueue + future per element, then get() on
+//                     each, the way main() in Thread Pool/main.cpp does
+//   parallel_*        parallelAlgorithms.hpp
+// plus a merge sort that recurses through parallel_invoke, and a
+// parallel_reduce whose body runs a parallel_for, which show the calls
+// nesting inside pool tasks. Results are checked against the serial
+// version.
+//
+// Usage: ParallelDemo [elements] [threads]
+
+template<typename Fn>
+double milliseconds(Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+void check(bool ok, const char* what) {
+    if (!ok) {
+        std::fprintf(stderr, "%s: wrong result\n", what);
+        std::exit(1);
+    }
+}
+
+// Sorts [begin, end) of `data`, using `scratch` for merging
+void mergeSort(ThreadPool& pool, std::vector<uint32_t>& data, std::vector<uint32_t>& scratch, size_t begin,
+               size_t end) {
+    if (end - begin <= 4096) {
+        std::sort(data.begin() + begin, data.begin() + end);
+        return;
+    }
+    size_t mid = begin + (end - begin) / 2;
+    parallel_invoke(pool, [&] { mergeSort(pool, data, scratch, begin, mid); },
+                    [&] { mergeSort(pool, data, scratch, mid, end); });
+    std::merge(data.begin() + begin, data.begin() + mid, data.begin() + mid, data.begin() + end,
+               scratch.begin() + begin);
+    std::copy(scratch.begin() + begin, scratch.begin() + end, data.begin() + begin);
+}
+
+int main(int argc, char* argv[]) {
+    const size_t n = argc > 1 ? std::stoull(argv[1]) : 4'000'000;
+    const int threads = argc > 2 ? std::stoi(argv[2]) : std::max(4u, std::thread::hardware_concurrency());
+
+    std::mt19937 rng(42);
+    std::vector<double> input(n);
+    for (double& x : input) x = std::uniform_real_distribution<double>(0.0, 100.0)(rng);
+    auto work = [](double x) { return std::sqrt(x) * std::log1p(x); };
+
+    ThreadPool pool(threads);
+    std::printf("%zu elements, %d threads (ms)\n", n, threads);
+
+    // ---- parallel_for: an element-wise transform ----
+    std::vector<double> expected(n), output(n);
+    double serial = milliseconds([&]() {
+        for (size_t i = 0; i < n; ++i) expected[i] = work(input[i]);
+    });
+
+    size_t per_item_n = std::min<size_t>(n, 200'000); // one future each: keep it bounded
+    double per_item = milliseconds([&]() {
+        std::vector<PoolFuture<void>> results;
+        results.reserve(per_item_n);
+        for (size_t i = 0; i < per_item_n; ++i) {
+            results.push_back(pool.enqueue([&, i] { output[i] = work(input[i]); }));
+        }
+        for (auto& fut : results) fut.get();
+    });
+
+    double looped = milliseconds([&]() {
+        parallel_for(pool, size_t{0}, n, [&](size_t i) { output[i] = work(input[i]); });
+    });
+    check(output == expected, "parallel_for");
+    std::printf("  transform  serial %8.2f   enqueue per item %8.2f (%zu items only)   parallel_for %8.2f\n",
+                serial, per_item, per_item_n, looped);
+
+    // ---- parallel_reduce: sum of squares, exact in integers ----
+    uint64_t expected_sum = 0;
+    serial = milliseconds([&]() {
+        for (size_t i = 0; i < n; ++i) expected_sum += static_cast<uint64_t>(i) * i % 1000003;
+    });
+    uint64_t sum = 0;
+    double reduced = milliseconds([&]() {
+        sum = parallel_reduce(
+            pool, size_t{0}, n, uint64_t{0},
+            [](size_t b, size_t e, uint64_t acc) {
+                for (size_t i = b; i < e; ++i) acc += static_cast<uint64_t>(i) * i % 1000003;
+                return acc;
+            },
+            [](uint64_t a, uint64_t b) { return a + b; });
+    });
+    check(sum == expected_sum, "parallel_reduce");
+    std::printf("  reduce     serial %8.2f   parallel_reduce %8.2f\n", serial, reduced);
+
+    // ---- parallel_reduce whose body nests a parallel_for ----
+    // While a piece waits for its inner loop, its thread runs other
+    // pieces of the same reduction; none of them may be lost
+    const size_t rows = std::min<size_t>(n / 64 + 1, 4096), columns = 64;
+    uint64_t nested_sum = parallel_reduce(
+        pool, size_t{0}, rows, uint64_t{0},
+        [&](size_t b, size_t e, uint64_t acc) {
+            for (size_t row = b; row < e; ++row) {
+                std::vector<uint64_t> cells(columns);
+                parallel_for(pool, size_t{0}, columns, [&](size_t c) { cells[c] = row * columns + c; }, 1);
+                for (uint64_t cell : cells) acc += cell;
+            }
+            return acc;
+        },
+        [](uint64_t a, uint64_t b) { return a + b; }, 1);
+    uint64_t cells_total = rows * columns;
+    check(nested_sum == cells_total * (cells_total - 1) / 2, "parallel_reduce with nested parallel_for");
+
+    // ---- parallel_invoke: recursive merge sort ----
+    std::vector<uint32_t> keys(n);
+    for (uint32_t& k : keys) k = static_cast<uint32_t>(rng());
+    std::vector<uint32_t> sorted = keys, scratch(n);
+    serial = milliseconds([&]() { std::sort(sorted.begin(), sorted.end()); });
+    double invoked = milliseconds([&]() { mergeSort(pool, keys, scratch, 0, n); });
+    check(keys == sorted, "parallel_invoke merge sort");
+    std::printf("  sort       std::sort %8.2f   parallel_invoke merge sort %8.2f\n", serial, invoked);
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include "caseConversion.hpp"
+#include "coalescingWriter.hpp"
+#include "mappedFile.hpp"
+#include "pipeline.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+// =============================================
+// Pipeline Demo: grep | tr a-z A-Z
+// =============================================
+// FileProcessor's read -> upper-case -> write, with a filter stage in
+// the middle, built on pipeline.hpp:
+//   read    source: ~4KB line-aligned slices of the mapped input
+//   filter  Parallel: keeps the lines containing the keyword
+//   upper   Parallel: SIMD upper-casing
+//   write   SerialInOrder: coalesced writev, in input order
+// The output equals `grep -F keyword input | tr a-z A-Z` for input that
+// ends in a newline.
+//
+// It runs twice: first with the thread budget split evenly over the
+// Parallel stages, then again after balance() has moved the threads to
+// where the first run spent its time. Both reports are printed.
+//
+// Usage: PipelineDemo input output [keyword] [threads]
+
+int main(int argc, char* argv[]) {
+    try {
+        if (argc < 3) throw std::runtime_error("Usage: PipelineDemo input output [keyword] [threads]");
+        const std::string output_path = argv[2];
+        const std::string keyword = argc > 3 ? argv[3] : "";
+        const size_t budget = argc > 4 ? std::stoul(argv[4]) : std::max(4u, std::thread::hardware_concurrency());
+        const size_t chunk_size = 4096;
+
+        MappedFile input(argv[1]);
+        LineRanges ranges(input.view(), (input.view().size() + chunk_size - 1) / chunk_size);
+        size_t next_range = 0;
+
+        int output_fd = -1;
+        std::unique_ptr<CoalescingWriter<std::string>> writer;
+
+        // One thread for the source and one for the writer; the rest
+        // split evenly to start with
+        size_t filter_threads = budget > 3 ? (budget - 2) / 2 : 1;
+        size_t upper_threads = budget > 3 ? budget - 2 - filter_threads : 1;
+
+        Pipeline pipeline;
+        pipeline
+            .source<std::string_view>("read", [&]() -> std::optional<std::string_view> {
+                if (next_range >= ranges.size()) return std::nullopt;
+                return ranges[next_range++];
+            })
+            .stage<std::string>("filter", StageMode::Parallel, filter_threads,
+                                [&](std::string_view slice) -> std::optional<std::string> {
+                std::string kept;
+                while (!slice.empty()) {
+                    size_t end = slice.find('\n');
+                    std::string_view line = slice.substr(0, end == std::string_view::npos ? slice.size() : end + 1);
+                    if (line.find(keyword) != std::string_view::npos) kept.append(line);
+                    slice.remove_prefix(line.size());
+                }
+                if (kept.empty()) return std::nullopt;
+                return kept;
+            })
+            .stage<std::string>("upper", StageMode::Parallel, upper_threads,
+                                [](std::string text) -> std::optional<std::string> {
+                toUpperInPlace(text.data(), text.size());
+                return text;
+            })
+            .sink("write", StageMode::SerialInOrder, 1, [&](std::string text) {
+                writer->append(std::move(text));
+            });
+
+        auto runOnce = [&](const char* label) {
+            next_range = 0;
+            output_fd = ::open(output_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+            if (output_fd < 0) {
+                throw std::runtime_error("Failed to open output file");
+            }
+            writer = std::make_unique<CoalescingWriter<std::string>>(output_fd, WritePolicy{});
+
+            PipelineReport report = pipeline.run();
+            writer->close();
+            writer.reset();
+            ::close(output_fd);
+
+            std::cout << label << ":\n";
+            report.print(std::cout);
+            return report;
+        };
+
+        PipelineReport even = runOnce("Even split");
+        pipeline.balance(budget, even);
+        runOnce("Balanced");
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include "threadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =============================================
+// Priority Lanes: Control Tasks Under a Bulk Flood
+// =============================================
+// The pool is filled with bulk tasks of ~`bulk_us` each, far more than
+// it can run during the test. Meanwhile a control thread submits one
+// short task every millisecond and records how long each waited from
+// submission to start. Done twice:
+//   fifo    everything through plain post(), one FIFO for all
+//   lanes   bulk in the Low lane, control tasks in the High lane with
+//           a 2 ms deadline
+// A third run floods the High lane instead and counts the Low tasks
+// that still get through, to show the lane rotation at work.
+//
+// Usage: PriorityDemo [control tasks] [threads]
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int bulk_us = 200;
+
+void spinFor(std::chrono::microseconds duration) {
+    auto until = Clock::now() + duration;
+    while (Clock::now() < until) {
+    }
+}
+
+struct Latency {
+    double p50, p99, max; // microseconds
+};
+
+Latency summarize(std::vector<double> waits) {
+    std::sort(waits.begin(), waits.end());
+    auto at = [&](double q) { return waits[static_cast<size_t>(q * (waits.size() - 1))]; };
+    return {at(0.50), at(0.99), waits.back()};
+}
+
+// Control tasks submitted at 1 kHz while `bulk` tasks are queued
+Latency controlLatency(ThreadPool& pool, int controls, size_t bulk, bool use_lanes) {
+    std::atomic<bool> finished{false};
+    std::atomic<size_t> bulk_done{0};
+    for (size_t i = 0; i < bulk; ++i) {
+        auto work = [&finished, &bulk_done] {
+            if (!finished.load(std::memory_order_relaxed)) spinFor(std::chrono::microseconds(bulk_us));
+            bulk_done.fetch_add(1, std::memory_order_release);
+        };
+        if (use_lanes) {
+            pool.post(TaskOptions{TaskPriority::Low, {}}, work);
+        } else {
+            pool.post(work);
+        }
+    }
+
+    std::vector<double> waits(controls);
+    std::atomic<int> done{0};
+    std::thread control([&] {
+        for (int i = 0; i < controls; ++i) {
+            auto submitted = Clock::now();
+            auto task = [&waits, &done, i, submitted] {
+                waits[i] = std::chrono::duration<double, std::micro>(Clock::now() - submitted).count();
+                done.fetch_add(1, std::memory_order_release);
+            };
+            if (use_lanes) {
+                pool.post(TaskOptions{TaskPriority::High, submitted + std::chrono::milliseconds(2)}, task);
+            } else {
+                pool.post(task);
+            }
+            std::this_thread::sleep_until(submitted + std::chrono::milliseconds(1));
+        }
+    });
+    control.join();
+    while (done.load(std::memory_order_acquire) < controls) std::this_thread::yield();
+
+    // Let the rest of the flood drain without doing the work
+    finished.store(true, std::memory_order_relaxed);
+    while (bulk_done.load(std::memory_order_acquire) < bulk) {
+        if (!pool.runPendingTask()) std::this_thread::yield();
+    }
+    return summarize(std::move(waits));
+}
+
+void printLanes(ThreadPool& pool) {
+    const char* names[] = {"High", "Normal", "Low"};
+    for (size_t p = 0; p < task_priority_count; ++p) {
+        LaneStats stats = pool.laneStats(static_cast<TaskPriority>(p));
+        std::printf("    %-6s depth %6zu  high water %6zu  submitted %7llu  deadline missed %5llu\n", names[p],
+                    stats.depth, stats.high_water, static_cast<unsigned long long>(stats.submitted),
+                    static_cast<unsigned long long>(stats.deadline_missed));
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const int controls = argc > 1 ? std::stoi(argv[1]) : 500;
+    const int threads = argc > 2 ? std::stoi(argv[2]) : std::max(4u, std::thread::hardware_concurrency());
+    // Enough bulk work to keep every thread busy for twice the test
+    const size_t bulk = static_cast<size_t>(controls) * threads * 2 * 1000 / bulk_us;
+
+    ThreadPool pool(threads);
+    std::printf("%d control tasks at 1 kHz, %zu bulk tasks of %d us, %d threads\n", controls, bulk, bulk_us,
+                threads);
+
+    Latency fifo = controlLatency(pool, controls, bulk, false);
+    Latency lanes = controlLatency(pool, controls, bulk, true);
+    std::printf("  submit-to-start (us)   p50 %10.1f   p99 %10.1f   max %10.1f   fifo\n", fifo.p50, fifo.p99,
+                fifo.max);
+    std::printf("  submit-to-start (us)   p50 %10.1f   p99 %10.1f   max %10.1f   lanes\n", lanes.p50, lanes.p99,
+                lanes.max);
+
+    // ---- Starvation: a High flood with Low work behind it ----
+    const int low_tasks = 100;
+    const int high_tasks = 20 * threads * 32;
+    std::atomic<int> low_done{0}, high_done{0};
+    std::atomic<int> low_before_high_finished{-1}; // set by the last High task
+    for (int i = 0; i < low_tasks; ++i) {
+        pool.post(TaskOptions{TaskPriority::Low, {}}, [&low_done] { low_done.fetch_add(1); });
+    }
+    for (int i = 0; i < high_tasks; ++i) {
+        pool.post(TaskOptions{TaskPriority::High, {}}, [&] {
+            spinFor(std::chrono::microseconds(50));
+            if (high_done.fetch_add(1) + 1 == high_tasks) low_before_high_finished.store(low_done.load());
+        });
+    }
+    while (low_before_high_finished.load() < 0 || low_done.load() < low_tasks) std::this_thread::yield();
+    std::printf("  High flood of %d tasks: %d of %d Low tasks ran before it finished\n", high_tasks,
+                low_before_high_finished.load(), low_tasks);
+
+    std::printf("  lane stats\n");
+    printLanes(pool);
+    return 0;
+}
@@ -0,0 +1,231 @@
+#include "lockFreeBuffer.hpp"
+#include "lockFreeRingBuffer.hpp"
+#include "mpmcQueue.hpp"
+#include "spscRingBuffer.hpp"
+#include "threadSafeQueue.hpp"
+#include "waitStrategy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =============================================
+// Queue Benchmark: Every Variant, Same Workloads
+// =============================================
+// Runs each queue over the same grid of workloads:
+//   element size  Bytes     (a push timestamp plus padding)
+//   capacity      Capacity  (slots; the std::queue variant is unbounded)
+//   topology      producers : consumers
+// and reports throughput plus p50 / p99 / p999 hand-off latency, i.e.
+// the time from just before push to just after pop of the same item.
+// When the consumer falls behind, that includes time spent queued, as
+// it does in a real pipeline.
+//
+// The SPSC buffers only run 1:1. They have no blocking calls, so
+// the adapter below spins with backoff on full and empty. Everything
+// else uses the queue's own blocking push/pop.
+//
+// Usage: QueueBenchmark [items per run] [name filter]
+
+using Clock = std::chrono::steady_clock;
+
+inline int64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+template<size_t Bytes>
+struct Payload {
+    static_assert(Bytes >= sizeof(int64_t), "Payload must hold its timestamp");
+    int64_t stamp = 0;
+    std::array<char, Bytes - sizeof(int64_t)> padding{};
+};
+
+inline void backoff(int& spins) {
+    if (++spins < 64) {
+        cpuRelax();
+    } else {
+        std::this_thread::yield();
+    }
+}
+
+// ---- Adapters: blocking push, pop that fails once closed and drained ----
+
+template<typename Buffer>
+class SpinningSpsc {
+    std::unique_ptr<Buffer> buffer = std::make_unique<Buffer>();
+    std::atomic<bool> closed{false};
+
+public:
+    static constexpr bool multi = false;
+
+    template<typename T>
+    void push(const T& item) {
+        int spins = 0;
+        while (!buffer->push(item)) backoff(spins);
+    }
+
+    template<typename T>
+    bool pop(T& item) {
+        int spins = 0;
+        while (!buffer->pop(item)) {
+            // Everything pushed before close() is visible by now
+            if (closed.load(std::memory_order_acquire)) return buffer->pop(item);
+            backoff(spins);
+        }
+        return true;
+    }
+
+    void close() { closed.store(true, std::memory_order_release); }
+};
+
+template<typename Queue>
+class Blocking {
+    Queue queue;
+
+public:
+    static constexpr bool multi = true;
+
+    template<typename... Args>
+    explicit Blocking(Args&&... args) : queue(std::forward<Args>(args)...) {}
+
+    template<typename T>
+    void push(const T& item) { queue.push(item); }
+
+    template<typename T>
+    bool pop(T& item) { return queue.pop(item); }
+
+    void close() {
+        if constexpr (requires { queue.shutdown(); }) {
+            queue.shutdown();
+        } else {
+            queue.close();
+        }
+    }
+};
+
+// ---- One run ----
+
+struct Topology {
+    size_t producers;
+    size_t consumers;
+};
+
+struct Result {
+    double ops_per_sec;
+    int64_t p50, p99, p999;
+};
+
+template<typename T, typename Queue>
+Result run(Queue& queue, Topology topology, uint64_t items) {
+    std::vector<std::vector<int64_t>> latencies(topology.consumers);
+    for (auto& samples : latencies) samples.reserve(items); // no allocation while timing
+
+    std::atomic<bool> go{false};
+    std::vector<std::thread> producers, consumers;
+
+    for (size_t c = 0; c < topology.consumers; ++c) {
+        consumers.emplace_back([&, c]() {
+            auto& samples = latencies[c];
+            T item;
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            while (queue.pop(item)) {
+                samples.push_back(nowNs() - item.stamp);
+            }
+        });
+    }
+    for (size_t p = 0; p < topology.producers; ++p) {
+        uint64_t share = items / topology.producers + (p < items % topology.producers ? 1 : 0);
+        producers.emplace_back([&, share]() {
+            T item;
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (uint64_t i = 0; i < share; ++i) {
+                item.stamp = nowNs();
+                queue.push(item);
+            }
+        });
+    }
+
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& p : producers) p.join();
+    queue.close();
+    for (auto& c : consumers) c.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<int64_t> all;
+    all.reserve(items);
+    for (auto& samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+    if (all.size() != items) {
+        std::cerr << "Lost items: expected " << items << " got " << all.size() << std::endl;
+        std::exit(1);
+    }
+
+    auto at = [&](double q) {
+        auto it = all.begin() + static_cast<std::ptrdiff_t>(q * (all.size() - 1));
+        std::nth_element(all.begin(), it, all.end());
+        return *it;
+    };
+    return {items / seconds, at(0.50), at(0.99), at(0.999)};
+}
+
+// ---- The grid ----
+
+struct Options {
+    uint64_t items;
+    std::string filter;
+};
+
+void report(const char* name, size_t bytes, size_t capacity, Topology topology, const Result& r) {
+    std::printf("%-20s %6zu %8zu %3zu:%-3zu %10.2f %10lld %10lld %10lld\n", name, bytes, capacity,
+                topology.producers, topology.consumers, r.ops_per_sec / 1e6, static_cast<long long>(r.p50),
+                static_cast<long long>(r.p99), static_cast<long long>(r.p999));
+    std::fflush(stdout);
+}
+
+template<typename Queue, typename T, typename... Args>
+void measure(const Options& options, const char* name, size_t capacity, Args... args) {
+    if (!options.filter.empty() && std::string(name).find(options.filter) == std::string::npos) return;
+
+    static constexpr Topology topologies[] = {{1, 1}, {1, 4}, {4, 1}, {4, 4}};
+    for (Topology topology : topologies) {
+        if (!Queue::multi && (topology.producers > 1 || topology.consumers > 1)) continue;
+        auto queue = std::make_unique<Queue>(args...);
+        report(name, sizeof(T), capacity, topology, run<T>(*queue, topology, options.items));
+    }
+}
+
+template<size_t Bytes, size_t Capacity>
+void measureAll(const Options& options) {
+    using T = Payload<Bytes>;
+
+    // The SPSC buffers keep one slot empty: Capacity slots hold Capacity - 1
+    measure<SpinningSpsc<LockFreeBuffer<T, Capacity>>, T>(options, "LockFreeBuffer", Capacity - 1);
+    measure<SpinningSpsc<LockFreeRingBuffer<T, Capacity>>, T>(options, "LockFreeRingBuffer", Capacity - 1);
+    measure<SpinningSpsc<SpscRingBuffer<T, Capacity>>, T>(options, "SpscRingBuffer", Capacity - 1);
+    measure<Blocking<MpmcQueue<T>>, T>(options, "MpmcQueue", Capacity, Capacity);
+    measure<Blocking<ThreadSafeQueue<T>>, T>(options, "ThreadSafeQueue", Capacity, Capacity);
+    measure<Blocking<LockedQueue<T>>, T>(options, "std::queue+mutex", 0);
+}
+
+int main(int argc, char* argv[]) {
+    Options options{argc > 1 ? std::stoull(argv[1]) : 200'000, argc > 2 ? argv[2] : ""};
+
+    std::cout << "Queue hand-off, " << options.items << " items per run"
+              << " (capacity 0 = unbounded, latency in ns)\n";
+    std::printf("%-20s %6s %8s %7s %10s %10s %10s %10s\n", "queue", "bytes", "capacity", "P:C", "Mops/s",
+                "p50", "p99", "p999");
+
+    measureAll<16, 64>(options);
+    measureAll<16, 4096>(options);
+    measureAll<256, 64>(options);
+    measureAll<256, 4096>(options);
+    return 0;
+}
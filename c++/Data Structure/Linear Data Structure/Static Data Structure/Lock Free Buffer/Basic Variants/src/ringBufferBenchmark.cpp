@@ -0,0 +1,179 @@
+#include "lockFreeBuffer.hpp"
+#include "lockFreeRingBuffer.hpp"
+#include "spscRingBuffer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =============================================
+// SPSC Throughput: LockFreeRingBuffer vs SpscRingBuffer
+// =============================================
+// One producer pushes `items` integers, one consumer pops them and
+// checks the order. Both sides spin (with yield) on full/empty so the
+// number is dominated by the buffer itself. The batched runs move
+// `batch` items per push_n/pop_n, i.e. one index publish per batch.
+
+void verify(uint64_t checksum, uint64_t items) {
+    if (checksum != items * (items - 1) / 2) {
+        std::cerr << "Checksum mismatch" << std::endl;
+        std::exit(1);
+    }
+}
+
+template<typename Buffer>
+double runThroughput(Buffer& buffer, uint64_t items) {
+    uint64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < items; ++i) {
+            while (!buffer.push(i)) {
+                std::this_thread::yield(); // wait if buffer is full
+            }
+        }
+    });
+
+    std::thread consumer([&]() {
+        uint64_t value;
+        for (uint64_t i = 0; i < items; ++i) {
+            while (!buffer.pop(value)) {
+                std::this_thread::yield(); // wait if buffer is empty
+            }
+            if (value != i) {
+                std::cerr << "Order broken: expected " << i << " got " << value << std::endl;
+                std::exit(1);
+            }
+            checksum += value;
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    verify(checksum, items);
+    return items / seconds;
+}
+
+template<typename Buffer>
+double runThroughput(uint64_t items) {
+    Buffer buffer;
+    return runThroughput(buffer, items);
+}
+
+template<typename Buffer>
+double runBatchedThroughput(uint64_t items, size_t batch) {
+    Buffer buffer;
+    uint64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread producer([&]() {
+        std::vector<uint64_t> run(batch);
+        uint64_t next = 0;
+        while (next < items) {
+            size_t count = std::min<uint64_t>(batch, items - next);
+            for (size_t k = 0; k < count; ++k) run[k] = next + k;
+
+            size_t sent = 0;
+            while (sent < count) {
+                size_t n = buffer.push_n(std::span<const uint64_t>(run.data() + sent, count - sent));
+                if (n == 0) std::this_thread::yield(); // wait if buffer is full
+                sent += n;
+            }
+            next += count;
+        }
+    });
+
+    std::thread consumer([&]() {
+        std::vector<uint64_t> run(batch);
+        uint64_t expected = 0;
+        while (expected < items) {
+            size_t n = buffer.pop_n(run);
+            if (n == 0) {
+                std::this_thread::yield(); // wait if buffer is empty
+                continue;
+            }
+            for (size_t k = 0; k < n; ++k) {
+                if (run[k] != expected) {
+                    std::cerr << "Order broken: expected " << expected << " got " << run[k] << std::endl;
+                    std::exit(1);
+                }
+                checksum += run[k];
+                ++expected;
+            }
+        }
+    });
+
+    producer.join();
+    consumer.join();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    verify(checksum, items);
+    return items / seconds;
+}
+
+// One run with BufferStats on: its throughput cost and what it sees
+template<size_t Size>
+void instrumented(uint64_t items, double baseline) {
+    LockFreeRingBuffer<uint64_t, Size, BufferStats> buffer;
+    double ops = runThroughput(buffer, items);
+    BufferStatsSnapshot s = buffer.stats();
+
+    std::cout << "  LockFreeRingBuffer + stats : " << ops / 1e6 << " M ops/s  (x" << ops / baseline << ")\n"
+              << "    full " << s.push_full << " / " << s.pushed << " pushes, empty " << s.pop_empty << " / "
+              << s.popped << " pops, high water " << s.high_water << " / " << s.capacity << "\n"
+              << "    residency p50 " << s.residencyAt(0.50).count() << " ns, p99 "
+              << s.residencyAt(0.99).count() << " ns, p999 " << s.residencyAt(0.999).count() << " ns\n";
+}
+
+template<size_t Size>
+void compare(uint64_t items, int rounds, size_t batch) {
+    using Basic = LockFreeRingBuffer<uint64_t, Size>;
+    using Spsc = SpscRingBuffer<uint64_t, Size>;
+
+    double basic = 0, spsc = 0, basic_batched = 0, spsc_batched = 0, buffer_batched = 0;
+    for (int r = 0; r < rounds; ++r) {
+        basic += runThroughput<Basic>(items);
+        spsc += runThroughput<Spsc>(items);
+        basic_batched += runBatchedThroughput<Basic>(items, batch);
+        spsc_batched += runBatchedThroughput<Spsc>(items, batch);
+        buffer_batched += runBatchedThroughput<LockFreeBuffer<uint64_t, Size>>(items, batch);
+    }
+
+    auto report = [&](const char* name, double total) {
+        double ops = total / rounds;
+        std::cout << "  " << name << ops / 1e6 << " M ops/s  (x" << ops / (basic / rounds) << ")\n";
+    };
+
+    std::cout << "Size " << Size << ", batch " << batch << ":\n";
+    report("LockFreeRingBuffer         : ", basic);
+    report("SpscRingBuffer             : ", spsc);
+    report("LockFreeRingBuffer push_n  : ", basic_batched);
+    report("SpscRingBuffer push_n      : ", spsc_batched);
+    report("LockFreeBuffer push_n      : ", buffer_batched);
+    instrumented<Size>(items, basic / rounds);
+}
+
+int main(int argc, char* argv[]) {
+    uint64_t items = argc > 1 ? std::stoull(argv[1]) : 10'000'000;
+    size_t batch = argc > 2 ? std::stoull(argv[2]) : 64;
+    const int rounds = 3;
+
+    std::cout << "SPSC throughput, " << items << " items, " << rounds << " rounds\n";
+    compare<1024>(items, rounds, batch);
+    compare<65536>(items, rounds, batch);
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "sharedMemoryRingBuffer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+// =============================================
+// Producer and Consumer in Separate Processes
+// =============================================
+// The parent produces; a forked child consumes. The first child
+// "crashes" halfway (_exit with the ring still attached, so its pid
+// stays in the consumer role), a second child takes that stale role
+// over and carries on from the same position. The exit code reports
+// whether the takeover happened and every item arrived exactly once,
+// in order.
+
+struct Message {
+    uint64_t sequence;
+    double value;
+    char text[16];
+};
+
+constexpr size_t ring_size = 1024;
+using Ring = SharedMemoryRingBuffer<Message, ring_size>;
+
+// Returns the next sequence it expects. With `crash`, the process
+// exits at `stop_at` instead, without running the ring's destructor.
+uint64_t consume(const char* name, uint64_t expected, uint64_t stop_at, bool crash = false) {
+    Ring ring(name, ShmRole::Consumer);
+    Message m;
+    while (expected < stop_at) {
+        if (!ring.pop_wait(m, std::chrono::seconds(5))) {
+            std::cerr << "[consumer " << getpid() << "] timed out" << std::endl;
+            _exit(2);
+        }
+        if (m.sequence != expected || m.value != expected * 0.5) {
+            std::cerr << "[consumer " << getpid() << "] expected " << expected << " got " << m.sequence << std::endl;
+            _exit(1);
+        }
+        ++expected;
+    }
+    if (crash) _exit(0);
+    return expected;
+}
+
+int main() {
+    const char* name = "/lock_free_ring_demo";
+    const uint64_t items = 2'000'000;
+    const uint64_t crash_at = items / 2;
+
+    Ring::unlink(name); // leftovers from an earlier run
+
+    pid_t first = fork();
+    if (first == 0) {
+        consume(name, 0, crash_at, true);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        Ring ring(name, ShmRole::Producer);
+
+        pid_t second = -1;
+        bool stale_role = false, taken_over = false;
+        for (uint64_t i = 0; i < items; ++i) {
+            Message m{i, i * 0.5, {}};
+            std::strncpy(m.text, "payload", sizeof(m.text) - 1);
+            ring.push_wait(m);
+
+            if (i + 1 == crash_at + ring_size / 2 && second < 0) {
+                int status = 0;
+                waitpid(first, &status, 0);
+                stale_role = ring.peerPid() == first && !ring.peerAttached();
+                std::cout << "[producer] first consumer gone (status " << WEXITSTATUS(status)
+                          << "), role still held by its pid: " << stale_role << std::endl;
+
+                second = fork();
+                if (second == 0) {
+                    uint64_t got = consume(name, crash_at, items);
+                    _exit(got == items ? 0 : 1);
+                }
+            }
+            if (second > 0 && !taken_over && ring.peerPid() == second) {
+                taken_over = true;
+                std::cout << "[producer] second consumer took over the role" << std::endl;
+            }
+        }
+
+        int status = 0;
+        waitpid(second, &status, 0);
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        // The second consumer may have claimed the role and detached again
+        // between two checks above; either way the stale pid is gone
+        if (!taken_over) taken_over = ring.peerPid() != first;
+        bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0 && stale_role && taken_over;
+        std::cout << "[producer] sent " << items << " messages across processes in " << seconds << " s ("
+                  << items / seconds / 1e6 << " M msg/s), second consumer "
+                  << (ok ? "received all in order" : "FAILED") << std::endl;
+        Ring::unlink(name);
+        return ok ? 0 : 1;
+    }
+}
@@ -0,0 +1,91 @@
+#include "spscRingBuffer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// =============================================
+// Copying push/pop vs claim/commit for 4 KB chunks
+// =============================================
+// Mirrors the chunk flow of ProducerConsumerManager: the producer
+// fills a 4 KB chunk, the consumer folds it into a checksum (stand-in
+// for the file write). push/pop copy every chunk into the slot and
+// back out again (2 x 4 KB per chunk); claim/commit and peek/release
+// touch the slot directly and copy nothing.
+
+constexpr size_t chunk_size = 4096;
+constexpr size_t buffer_size = 64;
+using ChunkBuffer = SpscRingBuffer<std::string, buffer_size>;
+
+void fillChunk(std::string& chunk, size_t index) {
+    chunk.assign(chunk_size, static_cast<char>('A' + index % 26));
+}
+
+uint64_t digest(const std::string& chunk) {
+    return static_cast<unsigned char>(chunk.front()) + static_cast<unsigned char>(chunk.back());
+}
+
+template<typename Producer, typename Consumer>
+void run(const char* name, Producer producer, Consumer consumer) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::thread p(producer);
+    uint64_t checksum = consumer();
+    p.join();
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << name << ": " << seconds * 1000 << " ms, checksum " << checksum << "\n";
+}
+
+int main() {
+    const size_t chunks = 1'000'000;
+
+    {
+        ChunkBuffer buffer;
+        run("push/pop     ",
+            [&]() {
+                std::string chunk;
+                for (size_t i = 0; i < chunks; ++i) {
+                    fillChunk(chunk, i);
+                    while (!buffer.push(chunk)) std::this_thread::yield();
+                }
+            },
+            [&]() {
+                std::string chunk;
+                uint64_t checksum = 0;
+                for (size_t i = 0; i < chunks; ++i) {
+                    while (!buffer.pop(chunk)) std::this_thread::yield();
+                    checksum += digest(chunk);
+                }
+                return checksum;
+            });
+    }
+
+    {
+        ChunkBuffer buffer;
+        run("claim/commit ",
+            [&]() {
+                for (size_t i = 0; i < chunks; ++i) {
+                    std::string* slot;
+                    while (!(slot = buffer.claim())) std::this_thread::yield();
+                    fillChunk(*slot, i); // built in place, reuses slot capacity
+                    buffer.commit();
+                }
+            },
+            [&]() {
+                uint64_t checksum = 0;
+                for (size_t i = 0; i < chunks; ++i) {
+                    std::string* slot;
+                    while (!(slot = buffer.peek())) std::this_thread::yield();
+                    checksum += digest(*slot); // read where it lies
+                    buffer.release();
+                }
+                return checksum;
+            });
+    }
+
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "lockFreeBuffer.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+// =============================================
+// Lock-Free Monitoring: printBuffer without the mutex
+// =============================================
+// The producer/printer pair from main.cpp, plus a consumer, all at full
+// speed: the producer pushes 0, 1, 2, ..., the consumer pops, and the
+// monitor snapshots the buffer as often as it can. A consistent
+// snapshot is a run of consecutive values, so every one is checked.
+// Once a second the monitor prints the latest one, like printBuffer.
+
+constexpr size_t buffer_size = 8;
+
+int main(int argc, char* argv[]) {
+    const int seconds = argc > 1 ? std::stoi(argv[1]) : 3;
+
+    LockFreeBuffer<uint64_t, buffer_size> buffer;
+    std::atomic<bool> running{true};
+
+    std::thread producer([&]() {
+        uint64_t next = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            if (buffer.push(next)) ++next;
+        }
+    });
+
+    std::thread consumer([&]() {
+        uint64_t value, expected = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            if (!buffer.pop(value)) continue;
+            if (value != expected++) {
+                std::cerr << "Order broken at " << value << std::endl;
+                std::exit(1);
+            }
+            std::this_thread::yield(); // a slower consumer keeps the buffer from running dry
+        }
+    });
+
+    std::vector<uint64_t> snapshot;
+    snapshot.reserve(buffer_size);
+    uint64_t exact = 0, partial = 0;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    auto next_print = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+
+    while (std::chrono::steady_clock::now() < deadline) {
+        (buffer.snapshot(snapshot) ? exact : partial)++;
+        for (size_t i = 1; i < snapshot.size(); ++i) {
+            if (snapshot[i] != snapshot[i - 1] + 1) {
+                std::cerr << "Inconsistent snapshot at " << snapshot[i] << std::endl;
+                std::exit(1);
+            }
+        }
+
+        if (std::chrono::steady_clock::now() >= next_print) {
+            next_print += std::chrono::seconds(1);
+            std::cout << "Buffer contents: ";
+            for (auto x : snapshot) std::cout << x << " ";
+            std::cout << std::endl;
+        }
+    }
+
+    running = false;
+    producer.join();
+    consumer.join();
+
+    std::cout << exact << " exact snapshots, " << partial << " trimmed after retries, all consistent\n";
+    return 0;
+}
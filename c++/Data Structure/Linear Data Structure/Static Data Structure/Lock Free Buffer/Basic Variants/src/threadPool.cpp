@@ -1,77 +1,3 @@
-#include <iostream>
-#include <thread>
-#include <vector>
-#include <queue>
-#include <mutex>
-#include <condition_variable>
-#include <functional>
-#include <chrono>
-#include <future>
-
-class ThreadPool {
-private:
-    int m_maxThread;
-    std::vector<std::thread> workers;
-    std::queue<std::function<void()>> tasks;
-
-    std::mutex queueMutex;
-    std::condition_variable condition;
-    bool stop;
-
-public:
-    ThreadPool(int i) : m_maxThread(i), stop(false) {
-        std::cout << "Constructor is called" << std::endl;
-        for (int i = 0; i < m_maxThread; ++i) {
-            workers.emplace_back([this] {
-                while (true) {
-                    std::function<void()> task;
-                    {
-                        std::unique_lock<std::mutex> lock(queueMutex);
-                        condition.wait(lock, [this] {
-                            return stop || !tasks.empty();
-                        });
-                        if (stop && tasks.empty())
-                            return;
-                        task = std::move(tasks.front());
-                        tasks.pop();
-                    }
-                    task();
-                }
-            });
-        }
-    }
-
-    ~ThreadPool() {
-        std::cout << "Destructor is called" << std::endl;
-        {
-            std::unique_lock<std::mutex> lock(queueMutex);
-            stop = true;
-        }
-        condition.notify_all();
-        for (std::thread &worker : workers) {
-            worker.join();
-        }
-    }
-
-    // Generic enqueue with return support
-    template <class F, class... Args>
-    auto enqueue(F&& f, Args&&... args)
-        -> std::future<typename std::invoke_result<F, Args...>::type> {
-
-        using return_type = typename std::invoke_result<F, Args...>::type;
-
-        auto task = std::make_shared<std::packaged_task<return_type()>>(
-            std::bind(std::forward<F>(f), std::forward<Args>(args)...)
-        );
-
-        std::future<return_type> res = task->get_future();
-        {
-            std::unique_lock<std::mutex> lock(queueMutex);
-            tasks.emplace([task]() {
-                (*task)();
-            });
-        }
-        condition.notify_one();
-        return res;
-    }
-};
\ No newline at end of file
+// The pool lives in include/threadPool.hpp; this file is kept so that
+// main.cpp's #include "threadPool.cpp" and the build keep working.
+#include "threadPool.hpp"
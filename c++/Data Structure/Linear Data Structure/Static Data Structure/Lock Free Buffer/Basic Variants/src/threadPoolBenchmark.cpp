@@ -0,0 +1,218 @@
+#include "threadPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+// =============================================
+// Thread Pool Throughput: Tiny Tasks
+// =============================================
+// Baseline is the original pool from Concurrency/Thread Pool/main.cpp:
+// one std::queue behind one mutex for every worker. Workloads:
+//   external  the main thread enqueues every task, then waits on all
+//             the futures (what main() in Thread Pool/main.cpp does)
+//   nested    each task enqueues two children down to a fixed depth,
+//             so nearly every submission comes from a worker
+//   post      external, through post(): no future at all (ThreadPool
+//             only)
+// Heap allocations per task are counted by replacing operator new.
+// ThreadPool's pools keep a few thousand free blocks, so "external"
+// with more tasks than that in flight at once goes back to the heap
+// for the excess, and grows the injection queue's overflow list.
+//
+// Usage: ThreadPoolBenchmark [tasks] [threads]
+
+// ---- Allocation counter ----
+
+// Every replaceable form is replaced, plain and aligned, single and
+// array, so BlockPool's aligned blocks are counted too. free() is kept
+// out of line: inlined into a delete expression, GCC pairs it with the
+// `new` and warns about a mismatched deallocation.
+
+static std::atomic<uint64_t> allocations{0};
+
+static void* countedAllocate(size_t size, size_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+    void* p = alignment <= alignof(std::max_align_t)
+                  ? std::malloc(size)
+                  : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+[[gnu::noinline]] static void countedFree(void* p) noexcept { std::free(p); }
+
+void* operator new(size_t size) { return countedAllocate(size, 0); }
+void* operator new[](size_t size) { return countedAllocate(size, 0); }
+void* operator new(size_t size, std::align_val_t align) { return countedAllocate(size, static_cast<size_t>(align)); }
+void* operator new[](size_t size, std::align_val_t align) { return countedAllocate(size, static_cast<size_t>(align)); }
+
+void operator delete(void* p) noexcept { countedFree(p); }
+void operator delete[](void* p) noexcept { countedFree(p); }
+void operator delete(void* p, size_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t) noexcept { countedFree(p); }
+void operator delete(void* p, std::align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { countedFree(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { countedFree(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { countedFree(p); }
+
+// ---- The original pool, as the baseline ----
+
+class MutexQueuePool {
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex queueMutex;
+    std::condition_variable condition;
+    bool stop = false;
+
+public:
+    explicit MutexQueuePool(int threads) {
+        for (int i = 0; i < threads; ++i) {
+            workers.emplace_back([this] {
+                while (true) {
+                    std::function<void()> task;
+                    {
+                        std::unique_lock<std::mutex> lock(queueMutex);
+                        condition.wait(lock, [this] { return stop || !tasks.empty(); });
+                        if (stop && tasks.empty()) return;
+                        task = std::move(tasks.front());
+                        tasks.pop();
+                    }
+                    task();
+                }
+            });
+        }
+    }
+
+    ~MutexQueuePool() {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            stop = true;
+        }
+        condition.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    template<class F, class... Args>
+    auto enqueue(F&& f, Args&&... args) -> std::future<typename std::invoke_result<F, Args...>::type> {
+        using return_type = typename std::invoke_result<F, Args...>::type;
+        auto task = std::make_shared<std::packaged_task<return_type()>>(
+            std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+        std::future<return_type> res = task->get_future();
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            tasks.emplace([task]() { (*task)(); });
+        }
+        condition.notify_one();
+        return res;
+    }
+};
+
+// ---- Workloads ----
+
+struct Rate {
+    double tasks_per_sec;
+    double allocations_per_task;
+};
+
+template<typename Fn>
+Rate measure(uint64_t tasks, Fn fn) {
+    uint64_t allocated = allocations.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    fn();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return {tasks / seconds,
+            static_cast<double>(allocations.load(std::memory_order_relaxed) - allocated) / tasks};
+}
+
+template<typename Pool>
+Rate external(Pool& pool, uint64_t tasks) {
+    std::atomic<uint64_t> sum{0};
+    std::vector<decltype(pool.enqueue([] {}))> results;
+    results.reserve(tasks); // outside the count
+    return measure(tasks, [&]() {
+        for (uint64_t i = 0; i < tasks; ++i) {
+            results.push_back(pool.enqueue([&sum, i] { sum.fetch_add(i, std::memory_order_relaxed); }));
+        }
+        for (auto& fut : results) fut.get();
+    });
+}
+
+// Binary tree of tasks, 2^(depth+1) - 1 in all; the futures are
+// dropped, completion is counted instead
+template<typename Pool>
+void spawn(Pool& pool, int depth, std::atomic<uint64_t>& done) {
+    if (depth > 0) {
+        pool.enqueue([&pool, depth, &done] { spawn(pool, depth - 1, done); });
+        pool.enqueue([&pool, depth, &done] { spawn(pool, depth - 1, done); });
+    }
+    done.fetch_add(1, std::memory_order_release);
+}
+
+template<typename Pool>
+Rate nested(Pool& pool, int depth) {
+    uint64_t tasks = (uint64_t{2} << depth) - 1;
+    std::atomic<uint64_t> done{0};
+    return measure(tasks, [&]() {
+        pool.enqueue([&pool, depth, &done] { spawn(pool, depth, done); });
+        while (done.load(std::memory_order_acquire) < tasks) std::this_thread::yield();
+    });
+}
+
+Rate posted(ThreadPool& pool, uint64_t tasks) {
+    std::atomic<uint64_t> done{0};
+    return measure(tasks, [&]() {
+        for (uint64_t i = 0; i < tasks; ++i) {
+            pool.post([&done] { done.fetch_add(1, std::memory_order_release); });
+        }
+        while (done.load(std::memory_order_acquire) < tasks) std::this_thread::yield();
+    });
+}
+
+void report(const char* name, const Rate& rate) {
+    std::printf("  %-24s %8.3f Mtasks/s %6.2f allocs/task\n", name, rate.tasks_per_sec / 1e6,
+                rate.allocations_per_task);
+}
+
+int main(int argc, char* argv[]) {
+    const uint64_t tasks = argc > 1 ? std::stoull(argv[1]) : 200'000;
+    const int threads = argc > 2 ? std::stoi(argv[2]) : std::max(4u, std::thread::hardware_concurrency());
+    int depth = 0;
+    while ((uint64_t{4} << depth) - 1 <= tasks) ++depth;
+
+    Rate mutex_external, mutex_nested, stealing_external, stealing_nested, stealing_post;
+    {
+        MutexQueuePool pool(threads);
+        mutex_external = external(pool, tasks);
+        mutex_nested = nested(pool, depth);
+    }
+    {
+        ThreadPool pool(threads);
+        external(pool, tasks); // warm the task and future pools
+        stealing_external = external(pool, tasks);
+        stealing_nested = nested(pool, depth);
+        stealing_post = posted(pool, tasks);
+    }
+
+    std::printf("Tiny tasks on %d threads\n", threads);
+    report("mutex + queue, external", mutex_external);
+    report("mutex + queue, nested", mutex_nested);
+    report("ThreadPool, external", stealing_external);
+    report("ThreadPool, nested", stealing_nested);
+    report("ThreadPool, post", stealing_post);
+    return 0;
+}